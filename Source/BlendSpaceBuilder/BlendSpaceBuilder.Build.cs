@@ -35,6 +35,8 @@ public class BlendSpaceBuilder : ModuleRules
 				"AnimationEditor",
 				"ClassViewer",
 				"PropertyEditor",
+				"Json",
+				"DerivedDataCache",
 			}
 		);
 	}
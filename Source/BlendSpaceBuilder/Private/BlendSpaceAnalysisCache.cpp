@@ -0,0 +1,174 @@
+#include "BlendSpaceAnalysisCache.h"
+#include "BlendSpaceBuilderSettings.h"
+#include "BlendSpaceAnalysisDerivedData.h"
+
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "Misc/ScopeLock.h"
+
+FBlendSpaceAnalysisCache& FBlendSpaceAnalysisCache::Get()
+{
+	static FBlendSpaceAnalysisCache Instance;
+	return Instance;
+}
+
+FString FBlendSpaceAnalysisCache::GetMatchName(const UAnimSequence* Animation, const FBlendSpaceAnalysisSettings& Settings)
+{
+	return UBlendSpaceBuilderSettings::StripSuffixes(Animation->GetName(), Settings.IgnorableSuffixes).ToLower();
+}
+
+float FBlendSpaceAnalysisCache::GetLegLength(const USkeleton* Skeleton, const FBlendSpaceAnalysisSettings& Settings)
+{
+	return FBlendSpaceFactory::GetSkeletonLegLength(Skeleton,
+		UBlendSpaceBuilderSettings::FindBoneByPatterns(Skeleton, Settings.LeftFootBonePatterns),
+		UBlendSpaceBuilderSettings::FindBoneByPatterns(Skeleton, Settings.RightFootBonePatterns));
+}
+
+uint32 FBlendSpaceAnalysisCache::GetTimingHash(const UAnimSequence* Animation)
+{
+	// Rate scale and looping change the velocity of a copy just like they change the source's
+	uint32 Hash = HashCombine(GetTypeHash(Animation->RateScale), GetTypeHash(Animation->bLoop));
+	for (const FAnimSyncMarker& Marker : Animation->AuthoredSyncMarkers)
+	{
+		Hash = HashCombine(Hash, HashCombine(GetTypeHash(Marker.MarkerName), GetTypeHash(Marker.Time)));
+	}
+	return Hash;
+}
+
+void FBlendSpaceAnalysisCache::Store(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, const FSHAHash& InputHash, const FBlendSpaceAnalysisResult& Result)
+{
+	if (!Animation || !Animation->GetSkeleton() || Result.Source == EBlendSpaceVelocitySource::None
+		|| !Options.GetSettings().bUseSessionAnalysisCache)
+	{
+		return;
+	}
+
+	FBlendSpaceAnalysisResult CachedResult = Result;
+	CachedResult.MirrorSource = nullptr;
+
+	const FBlendSpaceAnalysisSettings& Settings = Options.GetSettings();
+	if (!Settings.bReuseRetargetedAnalysis)
+	{
+		FScopeLock Lock(&CriticalSection);
+		Results.Add(InputHash, MoveTemp(CachedResult));
+		return;
+	}
+
+	FRetargetEntry Entry;
+	Entry.AnimationPath = FSoftObjectPath(Animation);
+	Entry.SkeletonPath = FSoftObjectPath(Animation->GetSkeleton());
+	Entry.NumFrames = Animation->GetNumberOfSampledKeys();
+	Entry.TimingHash = GetTimingHash(Animation);
+	Entry.OptionsHash = FBlendSpaceAnalysisDerivedData::GetOptionsHash(Options);
+	Entry.LegLength = GetLegLength(Animation->GetSkeleton(), Settings);
+	Entry.Result = CachedResult;
+	const FString MatchName = GetMatchName(Animation, Settings);
+
+	FScopeLock Lock(&CriticalSection);
+	Results.Add(InputHash, MoveTemp(CachedResult));
+
+	TArray<FRetargetEntry>& Candidates = RetargetEntries.FindOrAdd(MatchName);
+	FRetargetEntry* Existing = Candidates.FindByPredicate([&Entry](const FRetargetEntry& Other)
+	{
+		return Other.AnimationPath == Entry.AnimationPath && Other.OptionsHash == Entry.OptionsHash;
+	});
+	if (Existing)
+	{
+		*Existing = MoveTemp(Entry);
+	}
+	else
+	{
+		Candidates.Add(MoveTemp(Entry));
+	}
+}
+
+bool FBlendSpaceAnalysisCache::FindResult(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, const FBlendSpaceAnalysisDerivedData::FInputHashes& Hashes, FBlendSpaceAnalysisResult& OutResult) const
+{
+	if (!Animation || Options.bBypassCache || !Options.GetSettings().bUseSessionAnalysisCache)
+	{
+		return false;
+	}
+
+	// The input hash covers the clip's content, so an edited clip or a changed setting never matches
+	FScopeLock Lock(&CriticalSection);
+	const FBlendSpaceAnalysisResult* Found = Results.Find(Hashes.Exact);
+	if (!Found)
+	{
+		Found = Results.Find(Hashes.Requested);
+	}
+	if (!Found)
+	{
+		return false;
+	}
+	OutResult = *Found;
+	return true;
+}
+
+bool FBlendSpaceAnalysisCache::FindRetargetedResult(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, FBlendSpaceAnalysisResult& OutResult) const
+{
+	if (!Animation || !Animation->GetSkeleton() || Options.bBypassCache || !Options.GetSettings().bUseSessionAnalysisCache)
+	{
+		return false;
+	}
+
+	const FBlendSpaceAnalysisSettings& Settings = Options.GetSettings();
+	if (!Settings.bReuseRetargetedAnalysis)
+	{
+		return false;
+	}
+
+	const FSoftObjectPath SkeletonPath(Animation->GetSkeleton());
+	const FString MatchName = GetMatchName(Animation, Settings);
+	const int32 NumFrames = Animation->GetNumberOfSampledKeys();
+	const uint32 TimingHash = GetTimingHash(Animation);
+	const FSHAHash OptionsHash = FBlendSpaceAnalysisDerivedData::GetOptionsHash(Options);
+
+	FScopeLock Lock(&CriticalSection);
+	const TArray<FRetargetEntry>* Candidates = RetargetEntries.Find(MatchName);
+	if (!Candidates)
+	{
+		return false;
+	}
+
+	// Retargeting keeps the frame count and marker timing exactly; a same-named clip that differs is unrelated
+	for (const FRetargetEntry& Entry : *Candidates)
+	{
+		if (Entry.OptionsHash != OptionsHash
+			|| Entry.SkeletonPath == SkeletonPath
+			|| Entry.LegLength <= KINDA_SMALL_NUMBER
+			|| Entry.NumFrames != NumFrames
+			|| Entry.TimingHash != TimingHash)
+		{
+			continue;
+		}
+
+		const float TargetLegLength = GetLegLength(Animation->GetSkeleton(), Settings);
+		if (TargetLegLength <= KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		// Retargeting scales translation by the leg length ratio
+		const float Scale = TargetLegLength / Entry.LegLength;
+		OutResult = Entry.Result;
+		OutResult.Velocity *= Scale;
+		OutResult.ErrorEstimate *= Scale;
+		OutResult.NumKeysEvaluated = 0;
+		OutResult.RetargetSource = Entry.AnimationPath;
+		return true;
+	}
+	return false;
+}
+
+void FBlendSpaceAnalysisCache::Reset()
+{
+	FScopeLock Lock(&CriticalSection);
+	Results.Empty();
+	RetargetEntries.Empty();
+}
+
+int32 FBlendSpaceAnalysisCache::Num() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return Results.Num();
+}
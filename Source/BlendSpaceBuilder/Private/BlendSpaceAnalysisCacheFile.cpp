@@ -0,0 +1,401 @@
+#include "BlendSpaceAnalysisCacheFile.h"
+#include "BlendSpaceAnalysisDerivedData.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBlendSpaceAnalysisCacheFile, Log, All);
+
+// Header and records are copied and mapped as raw bytes
+static_assert(PLATFORM_LITTLE_ENDIAN, "The analysis cache file is stored little-endian");
+
+namespace BlendSpaceAnalysisCacheFileInternal
+{
+	constexpr uint32 FileMagic = 0x43425342; // "BSBC"
+	constexpr uint32 FileVersion = 1;
+
+	/** Seconds between checks of the default file's timestamp */
+	constexpr double ReloadCheckInterval = 1.0;
+
+	struct FFileHeader
+	{
+		uint32 Magic = FileMagic;
+		uint32 Version = FileVersion;
+		uint32 RecordSize = sizeof(FBlendSpaceAnalysisCacheRecord);
+		uint32 NumRecords = 0;
+		FGuid AnalysisVersion;
+	};
+	static_assert(sizeof(FFileHeader) == 32, "Analysis cache header is stored as raw bytes");
+
+	bool ValidateHeader(const FFileHeader& Header, int64 FileSize, FString& OutError)
+	{
+		if (Header.Magic != FileMagic)
+		{
+			OutError = TEXT("not an analysis cache file");
+		}
+		else if (Header.Version != FileVersion || Header.RecordSize != sizeof(FBlendSpaceAnalysisCacheRecord))
+		{
+			OutError = FString::Printf(TEXT("file version %u (record size %u) is not supported"), Header.Version, Header.RecordSize);
+		}
+		else if (Header.AnalysisVersion != FBlendSpaceAnalysisDerivedData::GetAnalysisVersion())
+		{
+			OutError = TEXT("written by another analysis version");
+		}
+		else if (FileSize != int64(sizeof(FFileHeader)) + int64(Header.NumRecords) * sizeof(FBlendSpaceAnalysisCacheRecord))
+		{
+			OutError = FString::Printf(TEXT("size does not match %u records"), Header.NumRecords);
+		}
+		else
+		{
+			return true;
+		}
+		return false;
+	}
+
+	/** Written instead of the file itself while the file is mapped and cannot be replaced */
+	FString GetPendingPath(const FString& FilePath)
+	{
+		return FilePath + TEXT(".pending");
+	}
+
+	/** The file or its pending replacement, whichever is newer (timestamp is FDateTime::MinValue when neither exists) */
+	FString ResolveNewestPath(const FString& FilePath, FDateTime& OutTimestamp)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		const FString PendingPath = GetPendingPath(FilePath);
+		const FDateTime Timestamp = FileManager.GetTimeStamp(*FilePath);
+		const FDateTime PendingTimestamp = FileManager.GetTimeStamp(*PendingPath);
+		OutTimestamp = PendingTimestamp > Timestamp ? PendingTimestamp : Timestamp;
+		return PendingTimestamp > Timestamp ? PendingPath : FilePath;
+	}
+
+	int8 FindCurveIndex(const TArray<FName>& CurveNames, FName CurveName)
+	{
+		const int32 Index = CurveNames.IndexOfByKey(CurveName);
+		return Index >= 0 && Index <= MAX_int8 ? int8(Index) : -1;
+	}
+}
+
+//=============================================================================
+// FBlendSpaceAnalysisCacheRecord
+//=============================================================================
+
+FBlendSpaceAnalysisCacheRecord FBlendSpaceAnalysisCacheRecord::Make(const FSHAHash& InputHash, const FBlendSpaceAnalysisResult& Result, const FBlendSpaceAnalysisSettings& Settings)
+{
+	using namespace BlendSpaceAnalysisCacheFileInternal;
+
+	FBlendSpaceAnalysisCacheRecord Record;
+	FMemory::Memcpy(Record.InputHash, InputHash.Hash, FSHA1::DigestSize);
+	Record.VelocityX = float(Result.Velocity.X);
+	Record.VelocityY = float(Result.Velocity.Y);
+	Record.ErrorEstimate = Result.ErrorEstimate;
+	Record.NumKeysEvaluated = Result.NumKeysEvaluated;
+	Record.Quality = uint8(Result.Quality);
+	Record.Source = uint8(Result.Source);
+	Record.ResolvedAnalysisType = uint8(Result.ResolvedAnalysisType);
+	Record.SourceCurveIndex = -1;
+	if (Result.Source == EBlendSpaceVelocitySource::SpeedCurve)
+	{
+		Record.SourceCurveIndex = FindCurveIndex(Settings.SpeedCurveNames, Result.SourceCurveName);
+	}
+	else if (Result.Source == EBlendSpaceVelocitySource::DistanceCurve)
+	{
+		Record.SourceCurveIndex = FindCurveIndex(Settings.DistanceCurveNames, Result.SourceCurveName);
+	}
+	return Record;
+}
+
+FBlendSpaceAnalysisResult FBlendSpaceAnalysisCacheRecord::ToResult(const FBlendSpaceAnalysisSettings& Settings) const
+{
+	FBlendSpaceAnalysisResult Result;
+	Result.Velocity = FVector(VelocityX, VelocityY, 0.0);
+	Result.ErrorEstimate = ErrorEstimate;
+	Result.NumKeysEvaluated = NumKeysEvaluated;
+	Result.Quality = EBlendSpaceAnalysisQuality(Quality);
+	Result.Source = EBlendSpaceVelocitySource(Source);
+	Result.ResolvedAnalysisType = EBlendSpaceAnalysisType(ResolvedAnalysisType);
+
+	// Curve names are part of the input hash, so the index refers to the same list it was written with
+	const TArray<FName>* CurveNames = Result.Source == EBlendSpaceVelocitySource::SpeedCurve ? &Settings.SpeedCurveNames
+		: Result.Source == EBlendSpaceVelocitySource::DistanceCurve ? &Settings.DistanceCurveNames
+		: nullptr;
+	if (CurveNames && CurveNames->IsValidIndex(SourceCurveIndex))
+	{
+		Result.SourceCurveName = (*CurveNames)[SourceCurveIndex];
+	}
+	return Result;
+}
+
+bool FBlendSpaceAnalysisCacheRecord::IsValid() const
+{
+	return FMath::IsFinite(VelocityX)
+		&& FMath::IsFinite(VelocityY)
+		&& FMath::IsFinite(ErrorEstimate)
+		&& ErrorEstimate >= 0.f
+		&& NumKeysEvaluated >= 0
+		&& Quality <= uint8(EBlendSpaceAnalysisQuality::Exact)
+		&& Source > uint8(EBlendSpaceVelocitySource::None)
+		&& Source <= uint8(EBlendSpaceVelocitySource::FootMarkers)
+		&& ResolvedAnalysisType <= uint8(EBlendSpaceAnalysisType::Auto);
+}
+
+//=============================================================================
+// FBlendSpaceAnalysisCacheFile
+//=============================================================================
+
+FString FBlendSpaceAnalysisCacheFile::GetDefaultPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("BlendSpaceBuilder") / TEXT("Analysis.bsbc");
+}
+
+TSharedRef<const FBlendSpaceAnalysisCacheFile, ESPMode::ThreadSafe> FBlendSpaceAnalysisCacheFile::Get()
+{
+	using namespace BlendSpaceAnalysisCacheFileInternal;
+
+	// Lookups race on analysis workers; the lock only guards swapping the instance
+	static FCriticalSection Mutex;
+	static TSharedRef<const FBlendSpaceAnalysisCacheFile, ESPMode::ThreadSafe> Instance = MakeShared<FBlendSpaceAnalysisCacheFile, ESPMode::ThreadSafe>();
+	static FDateTime MappedTimestamp = FDateTime::MinValue();
+	static double NextCheckTime = 0.0;
+
+	FScopeLock Lock(&Mutex);
+	const double Now = FPlatformTime::Seconds();
+	if (Now < NextCheckTime)
+	{
+		return Instance;
+	}
+	NextCheckTime = Now + ReloadCheckInterval;
+
+	// A commandlet run while the editor is open becomes visible without a restart
+	const FString FilePath = GetDefaultPath();
+	FDateTime Timestamp;
+	ResolveNewestPath(FilePath, Timestamp);
+	if (Timestamp == MappedTimestamp)
+	{
+		return Instance;
+	}
+	MappedTimestamp = Timestamp;
+
+	TSharedRef<FBlendSpaceAnalysisCacheFile, ESPMode::ThreadSafe> File = MakeShared<FBlendSpaceAnalysisCacheFile, ESPMode::ThreadSafe>();
+	FString Error;
+	if (File->Open(FilePath, &Error))
+	{
+		UE_LOG(LogBlendSpaceAnalysisCacheFile, Log, TEXT("Mapped %d analysis results from '%s'"), File->Records.Num(), *FilePath);
+	}
+	else if (!Error.IsEmpty())
+	{
+		UE_LOG(LogBlendSpaceAnalysisCacheFile, Warning, TEXT("Ignoring analysis cache file '%s': %s"), *FilePath, *Error);
+	}
+
+	// Lookups still holding the previous mapping finish on it; it is unmapped when the last of them lets go
+	Instance = File;
+	return Instance;
+}
+
+FBlendSpaceAnalysisCacheFile::~FBlendSpaceAnalysisCacheFile()
+{
+	// The region must be unmapped before its file handle closes
+	Records = {};
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+bool FBlendSpaceAnalysisCacheFile::Open(const FString& FilePath, FString* OutError)
+{
+	using namespace BlendSpaceAnalysisCacheFileInternal;
+
+	FString Error;
+	ON_SCOPE_EXIT
+	{
+		if (OutError)
+		{
+			*OutError = Error;
+		}
+	};
+
+	// A missing file is the normal case and not an error
+	FDateTime Timestamp;
+	const FString NewestPath = ResolveNewestPath(FilePath, Timestamp);
+	if (Timestamp == FDateTime::MinValue())
+	{
+		return false;
+	}
+
+	FOpenMappedResult MappedResult = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*NewestPath);
+	if (MappedResult.HasError())
+	{
+		Error = TEXT("could not be mapped");
+		return false;
+	}
+
+	TUniquePtr<IMappedFileHandle> Handle = MappedResult.StealValue();
+	const int64 FileSize = Handle->GetFileSize();
+	if (FileSize < int64(sizeof(FFileHeader)))
+	{
+		Error = TEXT("truncated header");
+		return false;
+	}
+
+	TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(0, FileSize));
+	if (!Region.IsValid())
+	{
+		Error = TEXT("could not be mapped");
+		return false;
+	}
+
+	const uint8* Data = Region->GetMappedPtr();
+	FFileHeader Header;
+	FMemory::Memcpy(&Header, Data, sizeof(FFileHeader));
+	if (!ValidateHeader(Header, FileSize, Error))
+	{
+		return false;
+	}
+
+	// Lookups binary search the records, so they must be valid and strictly sorted
+	const TConstArrayView<FBlendSpaceAnalysisCacheRecord> MappedRecords(
+		reinterpret_cast<const FBlendSpaceAnalysisCacheRecord*>(Data + sizeof(FFileHeader)), int32(Header.NumRecords));
+	for (int32 Index = 0; Index < MappedRecords.Num(); ++Index)
+	{
+		if (!MappedRecords[Index].IsValid())
+		{
+			Error = FString::Printf(TEXT("record %d is invalid"), Index);
+			return false;
+		}
+		if (Index > 0 && MappedRecords[Index - 1].CompareHash(MappedRecords[Index].InputHash) >= 0)
+		{
+			Error = FString::Printf(TEXT("record %d is out of order or duplicated"), Index);
+			return false;
+		}
+	}
+
+	Records = MappedRecords;
+	MappedRegion = MoveTemp(Region);
+	MappedFile = MoveTemp(Handle);
+	return true;
+}
+
+bool FBlendSpaceAnalysisCacheFile::Find(const FSHAHash& InputHash, const FBlendSpaceAnalysisSettings& Settings, FBlendSpaceAnalysisResult& OutResult) const
+{
+	int32 Low = 0;
+	int32 High = Records.Num();
+	while (Low < High)
+	{
+		const int32 Middle = Low + (High - Low) / 2;
+		const int32 Compare = Records[Middle].CompareHash(InputHash.Hash);
+		if (Compare == 0)
+		{
+			OutResult = Records[Middle].ToResult(Settings);
+			return true;
+		}
+		if (Compare < 0)
+		{
+			Low = Middle + 1;
+		}
+		else
+		{
+			High = Middle;
+		}
+	}
+	return false;
+}
+
+bool FBlendSpaceAnalysisCacheFile::Read(const FString& FilePath, TArray<FBlendSpaceAnalysisCacheRecord>& OutRecords, FString* OutError)
+{
+	using namespace BlendSpaceAnalysisCacheFileInternal;
+
+	FString Error;
+	ON_SCOPE_EXIT
+	{
+		if (OutError)
+		{
+			*OutError = Error;
+		}
+	};
+
+	FDateTime Timestamp;
+	const FString NewestPath = ResolveNewestPath(FilePath, Timestamp);
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *NewestPath, FILEREAD_Silent))
+	{
+		Error = TEXT("could not be read");
+		return false;
+	}
+	if (Data.Num() < int32(sizeof(FFileHeader)))
+	{
+		Error = TEXT("truncated header");
+		return false;
+	}
+
+	FFileHeader Header;
+	FMemory::Memcpy(&Header, Data.GetData(), sizeof(FFileHeader));
+	if (!ValidateHeader(Header, Data.Num(), Error))
+	{
+		return false;
+	}
+
+	OutRecords.SetNumUninitialized(Header.NumRecords);
+	FMemory::Memcpy(OutRecords.GetData(), Data.GetData() + sizeof(FFileHeader), OutRecords.Num() * sizeof(FBlendSpaceAnalysisCacheRecord));
+	return true;
+}
+
+bool FBlendSpaceAnalysisCacheFile::Write(const FString& FilePath, TArray<FBlendSpaceAnalysisCacheRecord> InRecords)
+{
+	using namespace BlendSpaceAnalysisCacheFileInternal;
+
+	InRecords.RemoveAllSwap([](const FBlendSpaceAnalysisCacheRecord& Record) { return !Record.IsValid(); });
+
+	// Sorted by hash, most precise first, so the first record of each hash is the one kept
+	InRecords.Sort([](const FBlendSpaceAnalysisCacheRecord& A, const FBlendSpaceAnalysisCacheRecord& B)
+	{
+		const int32 Compare = A.CompareHash(B.InputHash);
+		return Compare != 0 ? Compare < 0 : A.Quality > B.Quality;
+	});
+	TArray<FBlendSpaceAnalysisCacheRecord> Records;
+	Records.Reserve(InRecords.Num());
+	for (const FBlendSpaceAnalysisCacheRecord& Record : InRecords)
+	{
+		if (Records.Num() == 0 || Records.Last().CompareHash(Record.InputHash) != 0)
+		{
+			Records.Add(Record);
+		}
+	}
+
+	FFileHeader Header;
+	Header.NumRecords = uint32(Records.Num());
+	Header.AnalysisVersion = FBlendSpaceAnalysisDerivedData::GetAnalysisVersion();
+
+	TArray<uint8> Data;
+	Data.SetNumUninitialized(sizeof(FFileHeader) + Records.Num() * sizeof(FBlendSpaceAnalysisCacheRecord));
+	FMemory::Memcpy(Data.GetData(), &Header, sizeof(FFileHeader));
+	FMemory::Memcpy(Data.GetData() + sizeof(FFileHeader), Records.GetData(), Records.Num() * sizeof(FBlendSpaceAnalysisCacheRecord));
+
+	IFileManager& FileManager = IFileManager::Get();
+	const FString TempPath = FilePath + TEXT(".tmp");
+	const FString PendingPath = GetPendingPath(FilePath);
+	if (!FFileHelper::SaveArrayToFile(Data, *TempPath))
+	{
+		return false;
+	}
+	if (FileManager.Move(*FilePath, *TempPath, true))
+	{
+		// An older pending file may still be mapped; it loses to the newer file either way
+		FileManager.Delete(*PendingPath, false, false, true);
+		return true;
+	}
+
+	// The target is mapped by an editor (Windows does not replace mapped files); it swaps to the pending file on its next check
+	if (FileManager.Move(*PendingPath, *TempPath, true))
+	{
+		UE_LOG(LogBlendSpaceAnalysisCacheFile, Display, TEXT("'%s' is in use, wrote '%s' to replace it"), *FilePath, *PendingPath);
+		return true;
+	}
+	FileManager.Delete(*TempPath, false, false, true);
+	return false;
+}
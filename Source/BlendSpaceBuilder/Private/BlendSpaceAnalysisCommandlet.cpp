@@ -0,0 +1,584 @@
+#include "BlendSpaceAnalysisCommandlet.h"
+#include "BlendSpaceBuilderSettings.h"
+#include "BlendSpaceAnalysisDerivedData.h"
+#include "BlendSpaceAnalysisCacheFile.h"
+#include "BlendSpaceFactory.h"
+#include "BlendSpaceMemoryWindow.h"
+
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBlendSpaceAnalysisCommandlet, Log, All);
+
+namespace BlendSpaceAnalysisCommandletInternal
+{
+	// Worker exit codes
+	constexpr int32 ExitSuccess = 0;
+	constexpr int32 ExitFailed = 1;
+	constexpr int32 ExitMemoryCapExceeded = 2;
+
+	// Shard files are rewritten every few animations so a retried worker loses little work
+	constexpr int32 SaveInterval = 16;
+
+	constexpr int32 StoreVersion = 1;
+
+	struct FStoreEntry
+	{
+		FString SkeletonPath;
+		FBlendSpaceAnalysisResult Result;
+
+		/** Input hash of the analysis (see FBlendSpaceAnalysisDerivedData), keys the portable cache file */
+		FString InputHash;
+	};
+
+	template<typename TEnum>
+	FString EnumToString(TEnum Value)
+	{
+		return StaticEnum<TEnum>()->GetNameStringByValue(static_cast<int64>(Value));
+	}
+
+	template<typename TEnum>
+	bool EnumFromString(const FString& String, TEnum& OutValue)
+	{
+		const int64 Value = StaticEnum<TEnum>()->GetValueByNameString(String);
+		if (Value == INDEX_NONE)
+		{
+			return false;
+		}
+		OutValue = static_cast<TEnum>(Value);
+		return true;
+	}
+
+	TArray<FSoftObjectPath> FindAnimations(const TArray<FString>& PackagePaths)
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		AssetRegistry.SearchAllAssets(true);
+
+		FARFilter Filter;
+		Filter.ClassPaths.Add(UAnimSequence::StaticClass()->GetClassPathName());
+		Filter.bRecursiveClasses = true;
+		Filter.bRecursivePaths = true;
+		for (const FString& PackagePath : PackagePaths)
+		{
+			Filter.PackagePaths.Add(FName(*PackagePath));
+		}
+
+		TArray<FAssetData> AssetDataList;
+		AssetRegistry.GetAssets(Filter, AssetDataList);
+
+		// Every process must see the same order for shards to partition the set
+		TArray<FSoftObjectPath> Animations;
+		for (const FAssetData& AssetData : AssetDataList)
+		{
+			Animations.Add(AssetData.GetSoftObjectPath());
+		}
+		Animations.Sort([](const FSoftObjectPath& A, const FSoftObjectPath& B) { return A.ToString() < B.ToString(); });
+		return Animations;
+	}
+
+	// Contiguous range of the sorted animation set handled by a shard
+	void GetShardRange(int32 NumAnimations, int32 ShardIndex, int32 NumShards, int32& OutBegin, int32& OutEnd)
+	{
+		OutBegin = int32(int64(NumAnimations) * ShardIndex / NumShards);
+		OutEnd = int32(int64(NumAnimations) * (ShardIndex + 1) / NumShards);
+	}
+
+	FString GetShardFilePath(const FString& OutputPath, int32 ShardIndex, int32 NumShards)
+	{
+		return FPaths::GetBaseFilename(OutputPath, false) + FString::Printf(TEXT(".shard%dof%d.json"), ShardIndex, NumShards);
+	}
+
+	TSharedRef<FJsonObject> EntryToJson(const FString& AnimationPath, const FStoreEntry& Entry)
+	{
+		const FBlendSpaceAnalysisResult& Result = Entry.Result;
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetStringField(TEXT("Animation"), AnimationPath);
+		Object->SetStringField(TEXT("Skeleton"), Entry.SkeletonPath);
+		Object->SetNumberField(TEXT("VelocityX"), Result.Velocity.X);
+		Object->SetNumberField(TEXT("VelocityY"), Result.Velocity.Y);
+		Object->SetNumberField(TEXT("ErrorEstimate"), Result.ErrorEstimate);
+		Object->SetNumberField(TEXT("NumKeysEvaluated"), Result.NumKeysEvaluated);
+		Object->SetStringField(TEXT("Quality"), EnumToString(Result.Quality));
+		Object->SetStringField(TEXT("Source"), EnumToString(Result.Source));
+		Object->SetStringField(TEXT("SourceCurve"), Result.SourceCurveName.ToString());
+		Object->SetStringField(TEXT("AnalysisType"), EnumToString(Result.ResolvedAnalysisType));
+		Object->SetStringField(TEXT("InputHash"), Entry.InputHash);
+		return Object;
+	}
+
+	bool EntryFromJson(const FJsonObject& Object, FString& OutAnimationPath, FStoreEntry& OutEntry)
+	{
+		FBlendSpaceAnalysisResult& Result = OutEntry.Result;
+		FString Quality, Source, SourceCurve, AnalysisType;
+		double VelocityX = 0.0, VelocityY = 0.0, ErrorEstimate = 0.0;
+		if (!Object.TryGetStringField(TEXT("Animation"), OutAnimationPath)
+			|| !Object.TryGetStringField(TEXT("Skeleton"), OutEntry.SkeletonPath)
+			|| !Object.TryGetNumberField(TEXT("VelocityX"), VelocityX)
+			|| !Object.TryGetNumberField(TEXT("VelocityY"), VelocityY)
+			|| !Object.TryGetNumberField(TEXT("ErrorEstimate"), ErrorEstimate)
+			|| !Object.TryGetNumberField(TEXT("NumKeysEvaluated"), Result.NumKeysEvaluated)
+			|| !Object.TryGetStringField(TEXT("Quality"), Quality)
+			|| !Object.TryGetStringField(TEXT("Source"), Source)
+			|| !Object.TryGetStringField(TEXT("SourceCurve"), SourceCurve)
+			|| !Object.TryGetStringField(TEXT("AnalysisType"), AnalysisType))
+		{
+			return false;
+		}
+
+		// Stores written before the cache file existed have no hash; their entries are still usable
+		Object.TryGetStringField(TEXT("InputHash"), OutEntry.InputHash);
+
+		Result.Velocity = FVector(VelocityX, VelocityY, 0.0);
+		Result.ErrorEstimate = float(ErrorEstimate);
+		Result.SourceCurveName = FName(*SourceCurve);
+		return EnumFromString(Quality, Result.Quality)
+			&& EnumFromString(Source, Result.Source)
+			&& EnumFromString(AnalysisType, Result.ResolvedAnalysisType);
+	}
+
+	// Missing files load as empty; corrupt entries are dropped and re-analyzed
+	void LoadStore(const FString& FilePath, TMap<FString, FStoreEntry>& OutEntries)
+	{
+		FString Json;
+		if (!FFileHelper::LoadFileToString(Json, *FilePath))
+		{
+			return;
+		}
+
+		TSharedPtr<FJsonObject> Root;
+		const TArray<TSharedPtr<FJsonValue>>* Animations = nullptr;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid()
+			|| !Root->TryGetArrayField(TEXT("Animations"), Animations))
+		{
+			UE_LOG(LogBlendSpaceAnalysisCommandlet, Warning, TEXT("Ignoring unreadable store '%s'"), *FilePath);
+			return;
+		}
+
+		for (const TSharedPtr<FJsonValue>& Value : *Animations)
+		{
+			const TSharedPtr<FJsonObject>* Object = nullptr;
+			FString AnimationPath;
+			FStoreEntry Entry;
+			if (Value->TryGetObject(Object) && EntryFromJson(**Object, AnimationPath, Entry))
+			{
+				OutEntries.Add(AnimationPath, MoveTemp(Entry));
+			}
+		}
+	}
+
+	// Entries are written sorted by animation path, so equal contents always give identical files
+	bool SaveStore(const FString& FilePath, const TMap<FString, FStoreEntry>& Entries)
+	{
+		TArray<FString> AnimationPaths;
+		Entries.GenerateKeyArray(AnimationPaths);
+		AnimationPaths.Sort();
+
+		TArray<TSharedPtr<FJsonValue>> Animations;
+		for (const FString& AnimationPath : AnimationPaths)
+		{
+			Animations.Add(MakeShared<FJsonValueObject>(EntryToJson(AnimationPath, Entries[AnimationPath])));
+		}
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetNumberField(TEXT("Version"), StoreVersion);
+		Root->SetArrayField(TEXT("Animations"), Animations);
+
+		FString Json;
+		if (!FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json)))
+		{
+			return false;
+		}
+
+		// Write then move, so an interrupted worker never leaves a truncated file behind
+		const FString TempPath = FilePath + TEXT(".tmp");
+		return FFileHelper::SaveStringToFile(Json, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+			&& IFileManager::Get().Move(*FilePath, *TempPath, true);
+	}
+
+	// Cache file records of the store entries that carry an input hash
+	TArray<FBlendSpaceAnalysisCacheRecord> MakeCacheRecords(const TMap<FString, FStoreEntry>& Entries, const FBlendSpaceAnalysisSettings& Settings)
+	{
+		TArray<FBlendSpaceAnalysisCacheRecord> Records;
+		for (const auto& Pair : Entries)
+		{
+			FSHAHash InputHash;
+			if (Pair.Value.InputHash.Len() == FSHA1::DigestSize * 2 && Pair.Value.Result.Source != EBlendSpaceVelocitySource::None)
+			{
+				InputHash.FromString(Pair.Value.InputHash);
+				Records.Add(FBlendSpaceAnalysisCacheRecord::Make(InputHash, Pair.Value.Result, Settings));
+			}
+		}
+		return Records;
+	}
+
+	uint64 GetUsedMemoryMB()
+	{
+		return FPlatformMemory::GetStats().UsedPhysical / (1024 * 1024);
+	}
+}
+
+UBlendSpaceAnalysisCommandlet::UBlendSpaceAnalysisCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBlendSpaceAnalysisCommandlet::Main(const FString& Params)
+{
+	using namespace BlendSpaceAnalysisCommandletInternal;
+
+	if (!FParse::Value(*Params, TEXT("output="), OutputPath))
+	{
+		OutputPath = FPaths::ProjectSavedDir() / TEXT("BlendSpaceBuilder") / TEXT("AnalysisStore.json");
+	}
+	OutputPath = FPaths::ConvertRelativePathToFull(OutputPath);
+
+	if (!FParse::Value(*Params, TEXT("cachefile="), CacheFilePath))
+	{
+		CacheFilePath = FBlendSpaceAnalysisCacheFile::GetDefaultPath();
+	}
+	CacheFilePath = FPaths::ConvertRelativePathToFull(CacheFilePath);
+
+	if (FParse::Param(*Params, TEXT("validatecache")) || FParse::Param(*Params, TEXT("compactcache")))
+	{
+		return RunCacheFileTool(Params);
+	}
+
+	if (!FParse::Value(*Params, TEXT("paths="), PathsParam))
+	{
+		PathsParam = TEXT("/Game");
+	}
+	TArray<FString> PackagePaths;
+	PathsParam.ParseIntoArray(PackagePaths, TEXT("+"));
+
+	FParse::Value(*Params, TEXT("memorycapmb="), MemoryCapMB);
+
+	const TArray<FSoftObjectPath> Animations = FindAnimations(PackagePaths);
+
+	FString ShardParam;
+	if (FParse::Value(*Params, TEXT("shard="), ShardParam))
+	{
+		FString IndexString, CountString;
+		const int32 ShardIndex = ShardParam.Split(TEXT("/"), &IndexString, &CountString) ? FCString::Atoi(*IndexString) : -1;
+		const int32 NumShards = FCString::Atoi(*CountString);
+		if (NumShards <= 0 || ShardIndex < 0 || ShardIndex >= NumShards)
+		{
+			UE_LOG(LogBlendSpaceAnalysisCommandlet, Error, TEXT("Invalid -shard=%s, expected -shard=i/N with 0 <= i < N"), *ShardParam);
+			return ExitFailed;
+		}
+		return RunWorker(ShardIndex, NumShards, Animations);
+	}
+
+	return RunCoordinator(Params, Animations);
+}
+
+int32 UBlendSpaceAnalysisCommandlet::RunCoordinator(const FString& Params, const TArray<FSoftObjectPath>& Animations)
+{
+	using namespace BlendSpaceAnalysisCommandletInternal;
+
+	int32 NumWorkers = FMath::Max(1, FPlatformMisc::NumberOfCores() / 2);
+	int32 MaxRetries = 2;
+	FParse::Value(*Params, TEXT("workers="), NumWorkers);
+	FParse::Value(*Params, TEXT("retries="), MaxRetries);
+	NumWorkers = FMath::Clamp(NumWorkers, 1, FMath::Max(1, Animations.Num()));
+
+	UE_LOG(LogBlendSpaceAnalysisCommandlet, Display, TEXT("Analyzing %d animations in %d shards"), Animations.Num(), NumWorkers);
+
+	struct FShardProcess
+	{
+		FProcHandle Handle;
+		int32 Attempts = 0;
+
+		/** Exits that count against -retries: failures, and memory cap restarts that wrote nothing new */
+		int32 NumFailures = 0;
+
+		/** Animations in the shard file after the last exit */
+		int32 NumWritten = 0;
+		bool bRunning = false;
+		bool bSucceeded = false;
+	};
+	TArray<FShardProcess> Shards;
+	Shards.SetNum(NumWorkers);
+
+	// A new run starts from scratch; only retries within this run resume partial shard files
+	for (int32 ShardIndex = 0; ShardIndex < NumWorkers; ++ShardIndex)
+	{
+		IFileManager::Get().Delete(*GetShardFilePath(OutputPath, ShardIndex, NumWorkers));
+	}
+
+	const FString Executable = FPlatformProcess::ExecutablePath();
+	const FString ProjectFile = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	auto LaunchShard = [&](int32 ShardIndex)
+	{
+		const FString WorkerParams = FString::Printf(
+			TEXT("\"%s\" -run=BlendSpaceAnalysis -shard=%d/%d -paths=\"%s\" -output=\"%s\" -memorycapmb=%d -unattended -nopause -nullrhi -nosplash -nosound"),
+			*ProjectFile, ShardIndex, NumWorkers, *PathsParam, *OutputPath, MemoryCapMB);
+
+		FShardProcess& Shard = Shards[ShardIndex];
+		Shard.Handle = FPlatformProcess::CreateProc(*Executable, *WorkerParams, false, true, true, nullptr, 0, nullptr, nullptr);
+		Shard.bRunning = Shard.Handle.IsValid();
+		++Shard.Attempts;
+		if (!Shard.bRunning)
+		{
+			// Counted like a failed run, or the poll loop would relaunch it every second without limit
+			++Shard.NumFailures;
+			UE_LOG(LogBlendSpaceAnalysisCommandlet, Error, TEXT("Shard %d/%d: failed to launch worker (%d failure(s))"), ShardIndex, NumWorkers, Shard.NumFailures);
+		}
+	};
+
+	for (int32 ShardIndex = 0; ShardIndex < NumWorkers; ++ShardIndex)
+	{
+		LaunchShard(ShardIndex);
+	}
+
+	// Poll workers; failed shards are relaunched and resume from their shard file
+	bool bAnyRunning = true;
+	while (bAnyRunning)
+	{
+		FPlatformProcess::Sleep(1.0f);
+		bAnyRunning = false;
+		for (int32 ShardIndex = 0; ShardIndex < NumWorkers; ++ShardIndex)
+		{
+			FShardProcess& Shard = Shards[ShardIndex];
+			if (Shard.bRunning && !FPlatformProcess::IsProcRunning(Shard.Handle))
+			{
+				int32 ReturnCode = ExitFailed;
+				FPlatformProcess::GetProcReturnCode(Shard.Handle, &ReturnCode);
+				FPlatformProcess::CloseProc(Shard.Handle);
+				Shard.bRunning = false;
+				Shard.bSucceeded = ReturnCode == ExitSuccess;
+
+				if (!Shard.bSucceeded)
+				{
+					// A worker that hit the memory cap after writing results is a planned restart, not a failure
+					TMap<FString, FStoreEntry> ShardEntries;
+					LoadStore(GetShardFilePath(OutputPath, ShardIndex, NumWorkers), ShardEntries);
+					const bool bMadeProgress = ShardEntries.Num() > Shard.NumWritten;
+					Shard.NumWritten = ShardEntries.Num();
+					if (ReturnCode != ExitMemoryCapExceeded || !bMadeProgress)
+					{
+						++Shard.NumFailures;
+					}
+
+					UE_LOG(LogBlendSpaceAnalysisCommandlet, Warning, TEXT("Shard %d/%d: worker exited with %d%s (attempt %d, %d failure(s))"),
+						ShardIndex, NumWorkers, ReturnCode,
+						ReturnCode == ExitMemoryCapExceeded ? TEXT(" (memory cap)") : TEXT(""), Shard.Attempts, Shard.NumFailures);
+				}
+			}
+
+			if (!Shard.bRunning && !Shard.bSucceeded && Shard.NumFailures <= MaxRetries)
+			{
+				LaunchShard(ShardIndex);
+			}
+			bAnyRunning |= Shard.bRunning;
+		}
+	}
+
+	// Merge in shard order; shards partition the set, so the merged store is independent of timing
+	TMap<FString, FStoreEntry> Merged;
+	int32 NumFailedShards = 0;
+	for (int32 ShardIndex = 0; ShardIndex < NumWorkers; ++ShardIndex)
+	{
+		const FString ShardPath = GetShardFilePath(OutputPath, ShardIndex, NumWorkers);
+		LoadStore(ShardPath, Merged);
+		IFileManager::Get().Delete(*ShardPath);
+		NumFailedShards += Shards[ShardIndex].bSucceeded ? 0 : 1;
+	}
+
+	if (!SaveStore(OutputPath, Merged))
+	{
+		UE_LOG(LogBlendSpaceAnalysisCommandlet, Error, TEXT("Failed to write analysis store '%s'"), *OutputPath);
+		return ExitFailed;
+	}
+
+	UE_LOG(LogBlendSpaceAnalysisCommandlet, Display, TEXT("Wrote %d / %d animations to '%s' (%d shard(s) failed)"),
+		Merged.Num(), Animations.Num(), *OutputPath, NumFailedShards);
+
+	// Results of earlier runs stay in the cache file; records of clips that changed since are simply never found
+	TArray<FBlendSpaceAnalysisCacheRecord> Records;
+	FBlendSpaceAnalysisCacheFile::Read(CacheFilePath, Records);
+	Records.Append(MakeCacheRecords(Merged, *FBlendSpaceAnalysisSettings::Capture()));
+	if (!FBlendSpaceAnalysisCacheFile::Write(CacheFilePath, MoveTemp(Records)))
+	{
+		UE_LOG(LogBlendSpaceAnalysisCommandlet, Error, TEXT("Failed to write analysis cache file '%s'"), *CacheFilePath);
+		return ExitFailed;
+	}
+	return NumFailedShards == 0 ? ExitSuccess : ExitFailed;
+}
+
+int32 UBlendSpaceAnalysisCommandlet::RunWorker(int32 ShardIndex, int32 NumShards, const TArray<FSoftObjectPath>& Animations)
+{
+	using namespace BlendSpaceAnalysisCommandletInternal;
+
+	int32 Begin = 0;
+	int32 End = 0;
+	GetShardRange(Animations.Num(), ShardIndex, NumShards, Begin, End);
+
+	// Resume after the animations a previous attempt already wrote
+	const FString ShardPath = GetShardFilePath(OutputPath, ShardIndex, NumShards);
+	TMap<FString, FStoreEntry> Entries;
+	LoadStore(ShardPath, Entries);
+
+	const UBlendSpaceBuilderSettings* Settings = UBlendSpaceBuilderSettings::Get();
+	FBlendSpaceAnalysisOptions Options;
+	Options.AnalysisType = EBlendSpaceAnalysisType::Auto;
+	Options.Quality = EBlendSpaceAnalysisQuality::Exact;
+	Options.SettingsSnapshot = FBlendSpaceAnalysisSettings::Capture();
+
+	UE_LOG(LogBlendSpaceAnalysisCommandlet, Display, TEXT("Shard %d/%d: animations %d-%d (%d already done)"),
+		ShardIndex, NumShards, Begin, End, Entries.Num());
+
+	// Loaded animations are released in windows of the batch memory budget to keep worker memory flat
+	FBlendSpaceMemoryWindow MemoryWindow;
+	int32 NumSinceSave = 0;
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		const FString AnimationPath = Animations[Index].ToString();
+		if (Entries.Contains(AnimationPath))
+		{
+			continue;
+		}
+
+		UAnimSequence* Animation = nullptr;
+		{
+			FBlendSpaceMemoryWindow::FLoadScope LoadScope(MemoryWindow);
+			Animation = Cast<UAnimSequence>(Animations[Index].TryLoad());
+		}
+		if (!Animation || !Animation->GetSkeleton())
+		{
+			UE_LOG(LogBlendSpaceAnalysisCommandlet, Warning, TEXT("Shard %d/%d: could not load '%s'"), ShardIndex, NumShards, *AnimationPath);
+			continue;
+		}
+
+		Options.LeftFootBone = Settings->FindLeftFootBone(Animation->GetSkeleton());
+		Options.RightFootBone = Settings->FindRightFootBone(Animation->GetSkeleton());
+
+		FStoreEntry& Entry = Entries.Add(AnimationPath);
+		Entry.SkeletonPath = FSoftObjectPath(Animation->GetSkeleton()).ToString();
+
+		// Hashed once: the same hashes key the cache file, the DDC and the store entry
+		FBlendSpaceAnalysisDerivedData::FInputHashes InputHashes;
+		const bool bHasInputHashes = FBlendSpaceAnalysisDerivedData::GetInputHashes(Animation, Options, InputHashes);
+		if (!bHasInputHashes || !FBlendSpaceAnalysisDerivedData::Get(Animation, Options, InputHashes, Entry.Result))
+		{
+			Entry.Result = FBlendSpaceFactory::AnalyzeAnimation(Animation, Options);
+			if (bHasInputHashes)
+			{
+				FBlendSpaceAnalysisDerivedData::Put(Animation, Options, InputHashes.Requested, Entry.Result);
+			}
+		}
+		if (bHasInputHashes)
+		{
+			Entry.InputHash = InputHashes.Requested.ToString();
+		}
+
+		if (++NumSinceSave >= SaveInterval)
+		{
+			SaveStore(ShardPath, Entries);
+			NumSinceSave = 0;
+		}
+
+		const bool bOverCap = MemoryCapMB > 0 && GetUsedMemoryMB() > uint64(MemoryCapMB);
+		if (MemoryWindow.IsOverBudget() || bOverCap)
+		{
+			if (MemoryWindow.IsEnabled())
+			{
+				MemoryWindow.Release();
+			}
+			else
+			{
+				CollectGarbage(RF_NoFlags);
+			}
+
+			// Memory that survives a collection is not going to be released by this process
+			if (MemoryCapMB > 0 && GetUsedMemoryMB() > uint64(MemoryCapMB))
+			{
+				SaveStore(ShardPath, Entries);
+				UE_LOG(LogBlendSpaceAnalysisCommandlet, Warning, TEXT("Shard %d/%d: memory above %d MB after %d animations, exiting for retry"),
+					ShardIndex, NumShards, MemoryCapMB, Entries.Num());
+				return ExitMemoryCapExceeded;
+			}
+		}
+	}
+
+	if (!SaveStore(ShardPath, Entries))
+	{
+		UE_LOG(LogBlendSpaceAnalysisCommandlet, Error, TEXT("Shard %d/%d: failed to write '%s'"), ShardIndex, NumShards, *ShardPath);
+		return ExitFailed;
+	}
+
+	const FBlendSpaceAnalysisDerivedData::FStats Stats = FBlendSpaceAnalysisDerivedData::GetStats();
+	UE_LOG(LogBlendSpaceAnalysisCommandlet, Display, TEXT("Shard %d/%d: done (derived data cache: %d hits, %d misses)"),
+		ShardIndex, NumShards, Stats.Hits, Stats.Misses);
+	return ExitSuccess;
+}
+
+int32 UBlendSpaceAnalysisCommandlet::RunCacheFileTool(const FString& Params)
+{
+	using namespace BlendSpaceAnalysisCommandletInternal;
+
+	if (FParse::Param(*Params, TEXT("validatecache")))
+	{
+		FBlendSpaceAnalysisCacheFile CacheFile;
+		FString Error;
+		if (!CacheFile.Open(CacheFilePath, &Error))
+		{
+			UE_LOG(LogBlendSpaceAnalysisCommandlet, Error, TEXT("'%s' is not valid: %s"), *CacheFilePath, Error.IsEmpty() ? TEXT("file not found") : *Error);
+			return ExitFailed;
+		}
+
+		UE_LOG(LogBlendSpaceAnalysisCommandlet, Display, TEXT("'%s' is valid (%d records)"), *CacheFilePath, CacheFile.GetRecords().Num());
+		return ExitSuccess;
+	}
+
+	// An unreadable or outdated file compacts to an empty one
+	TArray<FBlendSpaceAnalysisCacheRecord> Records;
+	FString Error;
+	if (!FBlendSpaceAnalysisCacheFile::Read(CacheFilePath, Records, &Error))
+	{
+		UE_LOG(LogBlendSpaceAnalysisCommandlet, Warning, TEXT("Discarding records of '%s': %s"), *CacheFilePath, *Error);
+	}
+	const int32 NumRecordsBefore = Records.Num();
+
+	if (FParse::Param(*Params, TEXT("prune")))
+	{
+		TMap<FString, FStoreEntry> Entries;
+		LoadStore(OutputPath, Entries);
+
+		TSet<FString> ReferencedHashes;
+		for (const auto& Pair : Entries)
+		{
+			ReferencedHashes.Add(Pair.Value.InputHash);
+		}
+
+		FSHAHash InputHash;
+		Records.RemoveAllSwap([&ReferencedHashes, &InputHash](const FBlendSpaceAnalysisCacheRecord& Record)
+		{
+			FMemory::Memcpy(InputHash.Hash, Record.InputHash, FSHA1::DigestSize);
+			return !ReferencedHashes.Contains(InputHash.ToString());
+		});
+	}
+
+	if (!FBlendSpaceAnalysisCacheFile::Write(CacheFilePath, MoveTemp(Records)))
+	{
+		UE_LOG(LogBlendSpaceAnalysisCommandlet, Error, TEXT("Failed to write analysis cache file '%s'"), *CacheFilePath);
+		return ExitFailed;
+	}
+
+	FBlendSpaceAnalysisCacheFile CacheFile;
+	CacheFile.Open(CacheFilePath);
+	UE_LOG(LogBlendSpaceAnalysisCommandlet, Display, TEXT("Compacted '%s': %d -> %d records"),
+		*CacheFilePath, NumRecordsBefore, CacheFile.GetRecords().Num());
+	return ExitSuccess;
+}
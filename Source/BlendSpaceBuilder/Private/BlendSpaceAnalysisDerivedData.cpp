@@ -0,0 +1,280 @@
+#include "BlendSpaceAnalysisDerivedData.h"
+#include "BlendSpaceAnalysisCacheFile.h"
+
+#include "Animation/AnimSequence.h"
+#include "Animation/AnimData/IAnimationDataModel.h"
+#include "Animation/Skeleton.h"
+#include "DerivedDataCacheInterface.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBlendSpaceAnalysisDerivedData, Log, All);
+
+namespace BlendSpaceAnalysisDerivedDataInternal
+{
+	std::atomic<int32> NumHits = 0;
+	std::atomic<int32> NumMisses = 0;
+	std::atomic<int32> NumFileHits = 0;
+
+	void AppendNames(FString& Key, const TArray<FName>& Names)
+	{
+		for (FName Name : Names)
+		{
+			Key += TEXT("|") + Name.ToString();
+		}
+	}
+
+	/** Asset properties every velocity depends on (RateScale scales it, bLoop decides marker wrap), which the data model GUID does not cover */
+	void AppendPlaybackProperties(FString& Key, const UAnimSequence* Animation)
+	{
+		Key += FString::Printf(TEXT("|R:%g|L:%d"), Animation->RateScale, Animation->bLoop ? 1 : 0);
+	}
+
+	/** Foot-contact analysis reads markers and notifies, which the data model GUID does not cover */
+	void AppendMarkersAndNotifies(FString& Key, const UAnimSequence* Animation)
+	{
+		for (const FAnimSyncMarker& Marker : Animation->AuthoredSyncMarkers)
+		{
+			Key += FString::Printf(TEXT("|M:%s@%g#%d"), *Marker.MarkerName.ToString(), Marker.Time, Marker.TrackIndex);
+		}
+		for (const FAnimNotifyEvent& Notify : Animation->Notifies)
+		{
+			Key += FString::Printf(TEXT("|N:%s@%g#%d"), *Notify.NotifyName.ToString(), Notify.GetTriggerTime(), Notify.TrackIndex);
+		}
+	}
+
+	/** Analysis options and the settings the result depends on; bone names are appended by the caller */
+	void AppendOptions(FString& Key, const FBlendSpaceAnalysisOptions& Options)
+	{
+		const FBlendSpaceAnalysisSettings& Settings = Options.GetSettings();
+		Key += FString::Printf(TEXT("|%d|%d|%d|%d"),
+			int32(Options.AnalysisType), int32(Options.Quality), Options.bUseAuthoredCurves ? 1 : 0, int32(Options.AutoFootAnalysisType));
+		Key += FString::Printf(TEXT("|%g|%g|%g|%d|%g"),
+			Settings.MinVelocityThreshold, Settings.FootContactHeightTolerance, Settings.FootContactMaxVerticalSpeed,
+			Settings.bDetectLocomotionCycles ? 1 : 0, Settings.CycleDetectionMinCorrelation);
+		if (Options.bUseAuthoredCurves)
+		{
+			AppendNames(Key, Settings.SpeedCurveNames);
+			AppendNames(Key, Settings.DistanceCurveNames);
+		}
+		AppendNames(Key, Settings.LeftFootMarkerNames);
+		AppendNames(Key, Settings.RightFootMarkerNames);
+	}
+
+	/** Everything about the animation the result depends on (hashes the whole data model, so build it once per job) */
+	bool BuildAnimationKey(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, FString& OutKey)
+	{
+		const IAnimationDataModel* DataModel = Animation ? Animation->GetDataModel() : nullptr;
+		const USkeleton* Skeleton = Animation ? Animation->GetSkeleton() : nullptr;
+		if (!DataModel || !Skeleton)
+		{
+			return false;
+		}
+
+		// Names and numbers are written as text so hashes match across machines and sessions
+		OutKey = FBlendSpaceAnalysisDerivedData::GetAnalysisVersion().ToString();
+		OutKey += TEXT("|") + DataModel->GenerateGuid().ToString();
+		OutKey += TEXT("|") + FSoftObjectPath(Skeleton).ToString() + TEXT("|") + Skeleton->GetGuid().ToString();
+		AppendPlaybackProperties(OutKey, Animation);
+		AppendMarkersAndNotifies(OutKey, Animation);
+		AppendNames(OutKey, Options.GetContactBones());
+		return true;
+	}
+
+	void HashKey(const FString& Key, FSHAHash& OutHash)
+	{
+		FTCHARToUTF8 Utf8Key(*Key);
+		FSHA1::HashBuffer(Utf8Key.Get(), Utf8Key.Length(), OutHash.Hash);
+	}
+
+	void SerializeResult(FArchive& Ar, FBlendSpaceAnalysisResult& Result)
+	{
+		uint8 Quality = uint8(Result.Quality);
+		uint8 Source = uint8(Result.Source);
+		uint8 ResolvedAnalysisType = uint8(Result.ResolvedAnalysisType);
+		FString SourceCurveName = Result.SourceCurveName.IsNone() ? FString() : Result.SourceCurveName.ToString();
+
+		Ar << Result.Velocity;
+		Ar << Result.ErrorEstimate;
+		Ar << Quality;
+		Ar << Result.NumKeysEvaluated;
+		Ar << Source;
+		Ar << SourceCurveName;
+		Ar << ResolvedAnalysisType;
+
+		if (Ar.IsLoading())
+		{
+			Result.Quality = EBlendSpaceAnalysisQuality(Quality);
+			Result.Source = EBlendSpaceVelocitySource(Source);
+			Result.ResolvedAnalysisType = EBlendSpaceAnalysisType(ResolvedAnalysisType);
+			Result.SourceCurveName = SourceCurveName.IsEmpty() ? NAME_None : FName(*SourceCurveName);
+		}
+	}
+
+	bool GetCached(const FString& CacheKey, const UAnimSequence* Animation, FBlendSpaceAnalysisResult& OutResult)
+	{
+		TArray<uint8> Data;
+		if (!GetDerivedDataCacheRef().GetSynchronous(*CacheKey, Data, Animation->GetPathName()))
+		{
+			return false;
+		}
+
+		FMemoryReader Reader(Data);
+		SerializeResult(Reader, OutResult);
+		return !Reader.IsError();
+	}
+}
+
+const FGuid& FBlendSpaceAnalysisDerivedData::GetAnalysisVersion()
+{
+	static const FGuid AnalysisVersion(0x5D8A3F17, 0xC4E2469B, 0xA17B08E5, 0x3F96C2D4);
+	return AnalysisVersion;
+}
+
+bool FBlendSpaceAnalysisDerivedData::GetInputHash(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, FSHAHash& OutHash)
+{
+	using namespace BlendSpaceAnalysisDerivedDataInternal;
+
+	FString Key;
+	if (!BuildAnimationKey(Animation, Options, Key))
+	{
+		return false;
+	}
+	AppendOptions(Key, Options);
+
+	HashKey(Key, OutHash);
+	return true;
+}
+
+bool FBlendSpaceAnalysisDerivedData::GetInputHashes(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, FInputHashes& OutHashes)
+{
+	using namespace BlendSpaceAnalysisDerivedDataInternal;
+
+	FString AnimationKey;
+	if (!BuildAnimationKey(Animation, Options, AnimationKey))
+	{
+		return false;
+	}
+
+	FString Key = AnimationKey;
+	AppendOptions(Key, Options);
+	HashKey(Key, OutHashes.Requested);
+
+	if (Options.Quality == EBlendSpaceAnalysisQuality::Exact)
+	{
+		OutHashes.Exact = OutHashes.Requested;
+		return true;
+	}
+
+	FBlendSpaceAnalysisOptions ExactOptions = Options;
+	ExactOptions.Quality = EBlendSpaceAnalysisQuality::Exact;
+	Key = MoveTemp(AnimationKey);
+	AppendOptions(Key, ExactOptions);
+	HashKey(Key, OutHashes.Exact);
+	return true;
+}
+
+FSHAHash FBlendSpaceAnalysisDerivedData::GetOptionsHash(const FBlendSpaceAnalysisOptions& Options)
+{
+	using namespace BlendSpaceAnalysisDerivedDataInternal;
+
+	// Explicit contact bones are part of the options; detected foot bones belong to the skeleton
+	FString Key = GetAnalysisVersion().ToString();
+	AppendNames(Key, Options.ContactBones);
+	AppendOptions(Key, Options);
+
+	FSHAHash Hash;
+	HashKey(Key, Hash);
+	return Hash;
+}
+
+FString FBlendSpaceAnalysisDerivedData::GetCacheKey(const FSHAHash& InputHash)
+{
+	// Hashed to stay within the key length every DDC backend accepts
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("BLENDSPACEANALYSIS"), *GetAnalysisVersion().ToString(), *InputHash.ToString());
+}
+
+bool FBlendSpaceAnalysisDerivedData::Get(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, const FInputHashes& Hashes, FBlendSpaceAnalysisResult& OutResult)
+{
+	using namespace BlendSpaceAnalysisDerivedDataInternal;
+
+	const FBlendSpaceAnalysisSettings& Settings = Options.GetSettings();
+	if (!Animation || (!Settings.bUseDerivedDataCache && !Settings.bUseAnalysisCacheFile))
+	{
+		return false;
+	}
+
+	TArray<FSHAHash, TInlineAllocator<2>> InputHashes;
+	InputHashes.Add(Hashes.Exact);
+	if (Hashes.Requested != Hashes.Exact)
+	{
+		InputHashes.Add(Hashes.Requested);
+	}
+
+	// The checked-in file answers without any I/O beyond the mapped pages
+	if (Settings.bUseAnalysisCacheFile)
+	{
+		const TSharedRef<const FBlendSpaceAnalysisCacheFile, ESPMode::ThreadSafe> CacheFile = FBlendSpaceAnalysisCacheFile::Get();
+		for (const FSHAHash& InputHash : InputHashes)
+		{
+			if (CacheFile->Find(InputHash, Settings, OutResult))
+			{
+				++NumFileHits;
+				++NumHits;
+				return true;
+			}
+		}
+	}
+
+	bool bFound = false;
+	if (Settings.bUseDerivedDataCache)
+	{
+		for (const FSHAHash& InputHash : InputHashes)
+		{
+			if (GetCached(GetCacheKey(InputHash), Animation, OutResult))
+			{
+				bFound = true;
+				break;
+			}
+		}
+	}
+
+	if (bFound)
+	{
+		++NumHits;
+	}
+	else
+	{
+		++NumMisses;
+	}
+
+	UE_LOG(LogBlendSpaceAnalysisDerivedData, Verbose, TEXT("%s: %s"), *Animation->GetName(), bFound ? TEXT("hit") : TEXT("miss"));
+	return bFound;
+}
+
+void FBlendSpaceAnalysisDerivedData::Put(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, const FSHAHash& InputHash, const FBlendSpaceAnalysisResult& Result)
+{
+	using namespace BlendSpaceAnalysisDerivedDataInternal;
+
+	if (!Animation || !Options.GetSettings().bUseDerivedDataCache || Result.Source == EBlendSpaceVelocitySource::None)
+	{
+		return;
+	}
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	FBlendSpaceAnalysisResult Stored = Result;
+	SerializeResult(Writer, Stored);
+	GetDerivedDataCacheRef().Put(*GetCacheKey(InputHash), Data, Animation->GetPathName());
+}
+
+FBlendSpaceAnalysisDerivedData::FStats FBlendSpaceAnalysisDerivedData::GetStats()
+{
+	using namespace BlendSpaceAnalysisDerivedDataInternal;
+
+	FStats Stats;
+	Stats.Hits = NumHits;
+	Stats.Misses = NumMisses;
+	Stats.FileHits = NumFileHits;
+	return Stats;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+
+// Analysis helpers shared between the BlendSpace factory and the take segmenter (defined in BlendSpaceFactory.cpp)
+namespace BlendSpaceAnalysisInternal
+{
+	// Calculate reference pose component space transform by traversing parent chain
+	FTransform GetRefPoseComponentSpaceTransform(const FReferenceSkeleton& RefSkeleton, int32 BoneIndex);
+
+	// Evaluates component space positions of a set of contact bones with shared ancestors.
+	// The union of their parent chains is evaluated once per sample time in bone index order
+	// (parents always precede children in the reference skeleton), so the cost grows with the
+	// number of unique bones touched instead of contact bones * chain depth.
+	class FContactBoneSampler
+	{
+	public:
+		FContactBoneSampler(const UAnimSequence* InAnimation, const TArray<int32>& ContactBoneIndices)
+			: Animation(InAnimation)
+		{
+			const FReferenceSkeleton& RefSkeleton = Animation->GetSkeleton()->GetReferenceSkeleton();
+			const int32 NumBones = RefSkeleton.GetNum();
+
+			TBitArray<> RequiredMask(false, NumBones);
+			for (int32 BoneIndex : ContactBoneIndices)
+			{
+				for (int32 Current = BoneIndex; Current != INDEX_NONE && !RequiredMask[Current]; Current = RefSkeleton.GetParentIndex(Current))
+				{
+					RequiredMask[Current] = true;
+				}
+			}
+
+			// Compact the required bones, remapping parents to compact indices
+			TArray<int32> CompactIndices;
+			CompactIndices.Init(INDEX_NONE, NumBones);
+			for (TConstSetBitIterator<> It(RequiredMask); It; ++It)
+			{
+				const int32 BoneIndex = It.GetIndex();
+				const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+				CompactIndices[BoneIndex] = RequiredBones.Num();
+				RequiredBones.Add(BoneIndex);
+				RequiredParents.Add(ParentIndex != INDEX_NONE ? CompactIndices[ParentIndex] : INDEX_NONE);
+			}
+
+			for (int32 BoneIndex : ContactBoneIndices)
+			{
+				ContactSlots.Add(CompactIndices[BoneIndex]);
+			}
+			ComponentSpaceTransforms.SetNum(RequiredBones.Num());
+		}
+
+		// Evaluate contact bone positions at Time (OutPositions is parallel to the contact bone list)
+		void Sample(double Time, TArray<FVector>& OutPositions)
+		{
+			FAnimExtractContext ExtractContext(Time);
+			for (int32 i = 0; i < RequiredBones.Num(); ++i)
+			{
+				FTransform BoneLocalTM;
+				Animation->GetBoneTransform(BoneLocalTM, FSkeletonPoseBoneIndex(RequiredBones[i]), ExtractContext, false);
+				ComponentSpaceTransforms[i] = (RequiredParents[i] != INDEX_NONE)
+					? BoneLocalTM * ComponentSpaceTransforms[RequiredParents[i]]
+					: BoneLocalTM;
+			}
+
+			OutPositions.SetNum(ContactSlots.Num());
+			for (int32 i = 0; i < ContactSlots.Num(); ++i)
+			{
+				OutPositions[i] = ComponentSpaceTransforms[ContactSlots[i]].GetTranslation();
+			}
+		}
+
+		int32 GetNumRequiredBones() const
+		{
+			return RequiredBones.Num();
+		}
+
+	private:
+		const UAnimSequence* Animation = nullptr;
+		TArray<int32> RequiredBones;
+		TArray<int32> RequiredParents;
+		TArray<int32> ContactSlots;
+		TArray<FTransform> ComponentSpaceTransforms;
+	};
+}
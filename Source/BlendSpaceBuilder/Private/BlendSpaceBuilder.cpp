@@ -10,6 +10,7 @@
 #include "Styling/AppStyle.h"
 #include "Subsystems/AssetEditorSubsystem.h"
 #include "Editor.h"
+#include "Misc/ScopedSlowTask.h"
 
 // Animation Modifier
 #include "AnimationModifier.h"
@@ -31,6 +32,11 @@
 #include "LocomotionAnimClassifier.h"
 #include "BlendSpaceFactory.h"
 #include "BlendSpaceGaitConverter.h"
+#include "LocomotionTakeSegmenter.h"
+#include "BlendSpaceTimeSlicedExecutor.h"
+#include "BlendSpaceBulkGenerator.h"
+#include "BlendSpaceMemoryWindow.h"
+#include "BlendSpacePackageSaver.h"
 #include "UI/SBlendSpaceConfigDialog.h"
 #include "UI/SAxisRangeDialog.h"
 #include "UI/SBlendSpaceGaitConversionDialog.h"
@@ -55,6 +61,11 @@ void FBlendSpaceBuilderModule::RegisterContentBrowserMenuExtension()
 	Extenders.Add(FContentBrowserMenuExtender_SelectedAssets::CreateRaw(
 		this, &FBlendSpaceBuilderModule::OnExtendContentBrowserAssetSelectionMenu));
 	ContentBrowserExtenderDelegateHandle = Extenders.Last().GetHandle();
+
+	TArray<FContentBrowserMenuExtender_SelectedPaths>& PathExtenders = ContentBrowserModule.GetAllPathViewContextMenuExtenders();
+	PathExtenders.Add(FContentBrowserMenuExtender_SelectedPaths::CreateRaw(
+		this, &FBlendSpaceBuilderModule::OnExtendContentBrowserPathSelectionMenu));
+	ContentBrowserPathExtenderDelegateHandle = PathExtenders.Last().GetHandle();
 }
 
 void FBlendSpaceBuilderModule::UnregisterContentBrowserMenuExtension()
@@ -67,6 +78,12 @@ void FBlendSpaceBuilderModule::UnregisterContentBrowserMenuExtension()
 		{
 			return Delegate.GetHandle() == ContentBrowserExtenderDelegateHandle;
 		});
+
+		TArray<FContentBrowserMenuExtender_SelectedPaths>& PathExtenders = ContentBrowserModule.GetAllPathViewContextMenuExtenders();
+		PathExtenders.RemoveAll([this](const FContentBrowserMenuExtender_SelectedPaths& Delegate)
+		{
+			return Delegate.GetHandle() == ContentBrowserPathExtenderDelegateHandle;
+		});
 	}
 }
 
@@ -76,6 +93,7 @@ TSharedRef<FExtender> FBlendSpaceBuilderModule::OnExtendContentBrowserAssetSelec
 
 	bool bHasSkeletonOrMesh = false;
 	bool bHasBlendSpace = false;
+	bool bHasAnimSequence = false;
 
 	for (const FAssetData& Asset : SelectedAssets)
 	{
@@ -88,6 +106,10 @@ TSharedRef<FExtender> FBlendSpaceBuilderModule::OnExtendContentBrowserAssetSelec
 		{
 			bHasBlendSpace = true;
 		}
+		else if (Asset.AssetClassPath == UAnimSequence::StaticClass()->GetClassPathName())
+		{
+			bHasAnimSequence = true;
+		}
 	}
 
 	if (bHasSkeletonOrMesh)
@@ -110,6 +132,16 @@ TSharedRef<FExtender> FBlendSpaceBuilderModule::OnExtendContentBrowserAssetSelec
 		);
 	}
 
+	if (bHasAnimSequence)
+	{
+		Extender->AddMenuExtension(
+			"GetAssetActions",
+			EExtensionHook::After,
+			nullptr,
+			FMenuExtensionDelegate::CreateRaw(this, &FBlendSpaceBuilderModule::CreateAnimSequenceMenu, SelectedAssets)
+		);
+	}
+
 	return Extender;
 }
 
@@ -121,6 +153,83 @@ void FBlendSpaceBuilderModule::CreateBlendSpaceContextMenu(FMenuBuilder& MenuBui
 		FSlateIcon(FAppStyle::GetAppStyleSetName(), "ClassIcon.BlendSpace"),
 		FUIAction(FExecuteAction::CreateRaw(this, &FBlendSpaceBuilderModule::ExecuteGenerateLocomotionBlendSpace, SelectedAssets))
 	);
+
+	if (SelectedAssets.Num() > 1)
+	{
+		MenuBuilder.AddMenuEntry(
+			LOCTEXT("BulkGenerateLocomotionBlendSpaces", "Generate Locomotion BlendSpaces (Bulk)"),
+			LOCTEXT("BulkGenerateLocomotionBlendSpacesTooltip", "Generate a locomotion blend space for every selected skeleton without the dialog"),
+			FSlateIcon(FAppStyle::GetAppStyleSetName(), "ClassIcon.BlendSpace"),
+			FUIAction(FExecuteAction::CreateRaw(this, &FBlendSpaceBuilderModule::ExecuteBulkGenerateLocomotionBlendSpaces, SelectedAssets))
+		);
+	}
+}
+
+void FBlendSpaceBuilderModule::ExecuteBulkGenerateLocomotionBlendSpaces(TArray<FAssetData> SelectedAssets)
+{
+	TArray<FSoftObjectPath> SkeletonPaths;
+	for (const FAssetData& Asset : SelectedAssets)
+	{
+		if (Asset.AssetClassPath == USkeleton::StaticClass()->GetClassPathName())
+		{
+			SkeletonPaths.AddUnique(Asset.GetSoftObjectPath());
+		}
+		else if (Asset.AssetClassPath == USkeletalMesh::StaticClass()->GetClassPathName())
+		{
+			if (USkeletalMesh* Mesh = Cast<USkeletalMesh>(Asset.GetAsset()))
+			{
+				if (Mesh->GetSkeleton())
+				{
+					SkeletonPaths.AddUnique(FSoftObjectPath(Mesh->GetSkeleton()));
+				}
+			}
+		}
+	}
+
+	if (SkeletonPaths.Num() > 0)
+	{
+		FBlendSpaceBulkGenerator::Start(SkeletonPaths);
+	}
+}
+
+//=============================================================================
+// Folder Menu
+//=============================================================================
+
+TSharedRef<FExtender> FBlendSpaceBuilderModule::OnExtendContentBrowserPathSelectionMenu(const TArray<FString>& SelectedPaths)
+{
+	TSharedRef<FExtender> Extender = MakeShared<FExtender>();
+	Extender->AddMenuExtension(
+		"PathContextBulkOperations",
+		EExtensionHook::After,
+		nullptr,
+		FMenuExtensionDelegate::CreateRaw(this, &FBlendSpaceBuilderModule::CreatePathMenu, SelectedPaths)
+	);
+	return Extender;
+}
+
+void FBlendSpaceBuilderModule::CreatePathMenu(FMenuBuilder& MenuBuilder, TArray<FString> SelectedPaths)
+{
+	MenuBuilder.AddMenuEntry(
+		LOCTEXT("BulkGenerateInFolder", "Generate Locomotion BlendSpaces for Skeletons"),
+		LOCTEXT("BulkGenerateInFolderTooltip", "Generate a locomotion blend space for every skeleton in this folder and its subfolders"),
+		FSlateIcon(FAppStyle::GetAppStyleSetName(), "ClassIcon.BlendSpace"),
+		FUIAction(FExecuteAction::CreateRaw(this, &FBlendSpaceBuilderModule::ExecuteBulkGenerateInPaths, SelectedPaths))
+	);
+}
+
+void FBlendSpaceBuilderModule::ExecuteBulkGenerateInPaths(TArray<FString> SelectedPaths)
+{
+	const TArray<FSoftObjectPath> SkeletonPaths = FBlendSpaceBulkGenerator::FindSkeletonsInPaths(SelectedPaths);
+	if (SkeletonPaths.IsEmpty())
+	{
+		FNotificationInfo Info(LOCTEXT("NoSkeletonsInFolder", "No skeletons found in the selected folder"));
+		Info.ExpireDuration = 3.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+		return;
+	}
+
+	FBlendSpaceBulkGenerator::Start(SkeletonPaths);
 }
 
 void FBlendSpaceBuilderModule::ExecuteGenerateLocomotionBlendSpace(TArray<FAssetData> SelectedAssets)
@@ -169,14 +278,19 @@ void FBlendSpaceBuilderModule::ExecuteGenerateLocomotionBlendSpace(TArray<FAsset
 		.ParentWindow(Window)
 		.OnAccepted_Lambda([](const FBlendSpaceBuildConfig& Config)
 		{
-			UBlendSpace* CreatedBlendSpace = FBlendSpaceFactory::CreateLocomotionBlendSpace(Config);
-
-			if (CreatedBlendSpace)
+			// Asset creation is spread over editor frames
+			TSharedRef<FBlendSpaceTimeSlicedExecutor> Executor = MakeShared<FBlendSpaceTimeSlicedExecutor>(
+				FText::Format(LOCTEXT("CreatingBlendSpace", "Creating {0}"), FText::FromString(Config.AssetName)));
+			FBlendSpaceFactory::QueueLocomotionBlendSpaceCreation(*Executor, Config, [](UBlendSpace* CreatedBlendSpace)
 			{
-				TArray<UObject*> AssetsToSync;
-				AssetsToSync.Add(CreatedBlendSpace);
-				GEditor->SyncBrowserToObjects(AssetsToSync);
-			}
+				if (CreatedBlendSpace)
+				{
+					TArray<UObject*> AssetsToSync;
+					AssetsToSync.Add(CreatedBlendSpace);
+					GEditor->SyncBrowserToObjects(AssetsToSync);
+				}
+			});
+			Executor->Start();
 		});
 
 	Window->SetContent(Dialog);
@@ -317,20 +431,17 @@ UClass* FBlendSpaceBuilderModule::ShowModifierClassPicker()
 
 void FBlendSpaceBuilderModule::ExecuteApplyModifierToAllSamples(TArray<FAssetData> SelectedAssets)
 {
-	// Collect all BlendSpaces
-	TArray<UBlendSpace*> BlendSpaces;
+	// BlendSpaces are loaded one step at a time, so a large selection is never resident all at once
+	TArray<FSoftObjectPath> BlendSpacePaths;
 	for (const FAssetData& Asset : SelectedAssets)
 	{
 		if (Asset.AssetClassPath == UBlendSpace::StaticClass()->GetClassPathName())
 		{
-			if (UBlendSpace* BlendSpace = Cast<UBlendSpace>(Asset.GetAsset()))
-			{
-				BlendSpaces.Add(BlendSpace);
-			}
+			BlendSpacePaths.Add(Asset.GetSoftObjectPath());
 		}
 	}
 
-	if (BlendSpaces.IsEmpty())
+	if (BlendSpacePaths.IsEmpty())
 	{
 		return;
 	}
@@ -342,101 +453,147 @@ void FBlendSpaceBuilderModule::ExecuteApplyModifierToAllSamples(TArray<FAssetDat
 		return;
 	}
 
-	// Collect all unique animations from all BlendSpaces
-	TArray<UAnimSequence*> AllAnimations;
-	for (UBlendSpace* BlendSpace : BlendSpaces)
+	// Apply modifier to each animation, spread over editor frames
+	struct FApplyState
 	{
-		TArray<UAnimSequence*> Animations = GetAnimationsFromBlendSpace(BlendSpace);
-		for (UAnimSequence* Anim : Animations)
-		{
-			if (!AllAnimations.Contains(Anim))
-			{
-				AllAnimations.Add(Anim);
-			}
-		}
-	}
+		int32 SuccessCount = 0;
+		int32 FailCount = 0;
 
-	if (AllAnimations.IsEmpty())
-	{
-		FNotificationInfo Info(LOCTEXT("NoAnimationsFound", "No animations found in BlendSpace"));
-		Info.ExpireDuration = 3.0f;
-		FSlateNotificationManager::Get().AddNotification(Info);
-		return;
-	}
+		/** Animations shared by several BlendSpaces are modified once */
+		TSet<FSoftObjectPath> VisitedAnimations;
 
-	// Apply modifier to each animation
-	int32 SuccessCount = 0;
-	int32 FailCount = 0;
+		/** Saves the animations the batch loaded and modified before their memory window is released */
+		FBlendSpacePackageSaver Saver;
+		TUniquePtr<FBlendSpaceMemoryWindow> MemoryWindow;
+	};
+	TSharedRef<FApplyState> State = MakeShared<FApplyState>();
+	State->MemoryWindow = MakeUnique<FBlendSpaceMemoryWindow>();
 
+	TSharedRef<FBlendSpaceTimeSlicedExecutor> Executor = MakeShared<FBlendSpaceTimeSlicedExecutor>(
+		FText::Format(LOCTEXT("ApplyingModifier", "Applying {0}"), FText::FromString(ModifierClass->GetName())));
+	Executor->AddReferencedObject(ModifierClass);
+	for (const FSoftObjectPath& BlendSpacePath : BlendSpacePaths)
 	{
-		// Suppress warnings during batch apply
-		UE::Anim::FApplyModifiersScope Scope(UE::Anim::FApplyModifiersScope::SuppressWarning);
-
-		for (UAnimSequence* Anim : AllAnimations)
+		Executor->AddStep([this, BlendSpacePath, ModifierClass, State]()
 		{
-			if (!Anim)
+			TArray<UAnimSequence*> Animations;
 			{
-				continue;
+				FBlendSpaceMemoryWindow::FLoadScope LoadScope(*State->MemoryWindow);
+				Animations = GetAnimationsFromBlendSpace(Cast<UBlendSpace>(BlendSpacePath.TryLoad()));
 			}
+			for (UAnimSequence* Anim : Animations)
+			{
+				bool bAlreadyVisited = false;
+				State->VisitedAnimations.Add(FSoftObjectPath(Anim), &bAlreadyVisited);
+				if (bAlreadyVisited)
+				{
+					continue;
+				}
 
-			// Get or create AssetUserData
-			UAnimationModifiersAssetUserData* AssetUserData = Anim->GetAssetUserData<UAnimationModifiersAssetUserData>();
+				// Suppress warnings during batch apply
+				UE::Anim::FApplyModifiersScope Scope(UE::Anim::FApplyModifiersScope::SuppressWarning);
 
-			// Check if modifier of this class already exists and revert it
-			if (AssetUserData)
-			{
-				const TArray<UAnimationModifier*>& ExistingModifiers = AssetUserData->GetAnimationModifierInstances();
-				for (UAnimationModifier* ExistingModifier : ExistingModifiers)
+				// Get or create AssetUserData
+				UAnimationModifiersAssetUserData* AssetUserData = Anim->GetAssetUserData<UAnimationModifiersAssetUserData>();
+
+				// Check if modifier of this class already exists and revert it
+				if (AssetUserData)
 				{
-					if (ExistingModifier && ExistingModifier->GetClass() == ModifierClass)
+					const TArray<UAnimationModifier*>& ExistingModifiers = AssetUserData->GetAnimationModifierInstances();
+					for (UAnimationModifier* ExistingModifier : ExistingModifiers)
 					{
-						ExistingModifier->RevertFromAnimationSequence(Anim);
+						if (ExistingModifier && ExistingModifier->GetClass() == ModifierClass)
+						{
+							ExistingModifier->RevertFromAnimationSequence(Anim);
+						}
 					}
 				}
-			}
 
-			// Add and apply new modifier
-			bool bSuccess = UAnimationModifiersAssetUserData::AddAnimationModifierOfClass(Anim, TSubclassOf<UAnimationModifier>(ModifierClass));
-			if (bSuccess)
-			{
-				// Get the newly added modifier and apply it
-				AssetUserData = Anim->GetAssetUserData<UAnimationModifiersAssetUserData>();
-				if (AssetUserData)
+				// Add and apply new modifier
+				bool bSuccess = UAnimationModifiersAssetUserData::AddAnimationModifierOfClass(Anim, TSubclassOf<UAnimationModifier>(ModifierClass));
+				if (bSuccess)
 				{
-					const TArray<UAnimationModifier*>& Modifiers = AssetUserData->GetAnimationModifierInstances();
-					for (UAnimationModifier* Modifier : Modifiers)
+					// Get the newly added modifier and apply it
+					AssetUserData = Anim->GetAssetUserData<UAnimationModifiersAssetUserData>();
+					if (AssetUserData)
 					{
-						if (Modifier && Modifier->GetClass() == ModifierClass)
+						const TArray<UAnimationModifier*>& Modifiers = AssetUserData->GetAnimationModifierInstances();
+						for (UAnimationModifier* Modifier : Modifiers)
 						{
-							Modifier->ApplyToAnimationSequence(Anim);
-							break;
+							if (Modifier && Modifier->GetClass() == ModifierClass)
+							{
+								Modifier->ApplyToAnimationSequence(Anim);
+								break;
+							}
 						}
 					}
+					State->SuccessCount++;
+				}
+				else
+				{
+					State->FailCount++;
+				}
+				if (State->MemoryWindow->IsReleasable(Anim->GetOutermost()))
+				{
+					State->Saver.Add(Anim);
 				}
-				SuccessCount++;
 			}
-			else
+
+			// Modified animations of a full window are saved so the window can be released. They already exist on
+			// disk, so the saver checks them out through the editor save (one checkout per window) before writing.
+			if (State->MemoryWindow->IsOverBudget())
 			{
-				FailCount++;
+				State->Saver.SavePending();
+				State->Saver.Wait();
+				State->MemoryWindow->Release();
 			}
-		}
+		});
 	}
 
-	// Show notification
-	FText Message = FText::Format(
-		LOCTEXT("ModifierApplyResult", "Applied {0} to {1} animations ({2} failed)"),
-		FText::FromString(ModifierClass->GetName()),
-		FText::AsNumber(SuccessCount),
-		FText::AsNumber(FailCount));
-
-	FNotificationInfo Info(Message);
-	Info.ExpireDuration = 5.0f;
-	Info.bUseSuccessFailIcons = true;
-	TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info);
-	if (Notification.IsValid())
+	const FString ModifierName = ModifierClass->GetName();
+	Executor->OnCompleted().BindLambda([State, ModifierName](bool bCancelled)
 	{
-		Notification->SetCompletionState(FailCount == 0 ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
-	}
+		// The last window (and a run that never went over budget) is saved too, so the batch never leaves
+		// animations it loaded itself dirty, whether it finished or was cancelled
+		State->Saver.SavePending();
+		State->Saver.Wait();
+		State->MemoryWindow.Reset();
+		if (State->SuccessCount + State->FailCount == 0)
+		{
+			FNotificationInfo Info(LOCTEXT("NoAnimationsFound", "No animations found in BlendSpace"));
+			Info.ExpireDuration = 3.0f;
+			FSlateNotificationManager::Get().AddNotification(Info);
+			return;
+		}
+
+		// Show notification
+		FText Message = FText::Format(
+			LOCTEXT("ModifierApplyResult", "Applied {0} to {1} animations ({2} failed) and saved {3} modified animation(s)"),
+			FText::FromString(ModifierName),
+			FText::AsNumber(State->SuccessCount),
+			FText::AsNumber(State->FailCount),
+			FText::AsNumber(State->Saver.GetNumWritten()));
+
+		// Animations that could not be checked out stay dirty (and loaded) for the user to save
+		const int32 NumSaveFailed = State->Saver.GetNumFailed();
+		if (NumSaveFailed > 0)
+		{
+			Message = FText::Format(
+				LOCTEXT("ModifierApplySaveFailed", "{0}; {1} modified animation(s) could not be saved (check out or make writable, then save)"),
+				Message,
+				FText::AsNumber(NumSaveFailed));
+		}
+
+		FNotificationInfo Info(Message);
+		Info.ExpireDuration = 5.0f;
+		Info.bUseSuccessFailIcons = true;
+		TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info);
+		if (Notification.IsValid())
+		{
+			Notification->SetCompletionState(State->FailCount == 0 && NumSaveFailed == 0 ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		}
+	});
+	Executor->Start();
 }
 
 //=============================================================================
@@ -557,81 +714,91 @@ void FBlendSpaceBuilderModule::ExecuteAdjustAxisRange(TArray<FAssetData> Selecte
 		const float NewYMin = Dialog->GetYMin();
 		const float NewYMax = Dialog->GetYMax();
 
-		// Apply to all selected BlendSpaces
-		int32 ModifiedCount = 0;
+		// Apply to all selected BlendSpaces, spread over editor frames
+		TSharedRef<int32> ModifiedCount = MakeShared<int32>(0);
+		TSharedRef<FBlendSpaceTimeSlicedExecutor> Executor = MakeShared<FBlendSpaceTimeSlicedExecutor>(
+			LOCTEXT("AdjustingAxisRange", "Adjusting axis range"));
 
 		for (UBlendSpace* BlendSpace : BlendSpaces)
 		{
-			BlendSpace->Modify();
-
-			// Get old axis ranges before modification
-			const FBlendParameter& OldXParam = BlendSpace->GetBlendParameter(0);
-			const FBlendParameter& OldYParam = BlendSpace->GetBlendParameter(1);
-			const float OldXMin = OldXParam.Min;
-			const float OldXMax = OldXParam.Max;
-			const float OldYMin = OldYParam.Min;
-			const float OldYMax = OldYParam.Max;
-
-			// Remap sample positions proportionally to the new range
-			FProperty* SampleDataProperty = UBlendSpace::StaticClass()->FindPropertyByName(TEXT("SampleData"));
-			if (SampleDataProperty)
+			Executor->AddReferencedObject(BlendSpace);
+			Executor->AddStep([BlendSpace, NewXMin, NewXMax, NewYMin, NewYMax, ModifiedCount]()
 			{
-				TArray<FBlendSample>* SampleData = SampleDataProperty->ContainerPtrToValuePtr<TArray<FBlendSample>>(BlendSpace);
-				if (SampleData)
+				BlendSpace->Modify();
+
+				// Get old axis ranges before modification
+				const FBlendParameter& OldXParam = BlendSpace->GetBlendParameter(0);
+				const FBlendParameter& OldYParam = BlendSpace->GetBlendParameter(1);
+				const float OldXMin = OldXParam.Min;
+				const float OldXMax = OldXParam.Max;
+				const float OldYMin = OldYParam.Min;
+				const float OldYMax = OldYParam.Max;
+
+				// Remap sample positions proportionally to the new range
+				FProperty* SampleDataProperty = UBlendSpace::StaticClass()->FindPropertyByName(TEXT("SampleData"));
+				if (SampleDataProperty)
 				{
-					const float OldXRange = OldXMax - OldXMin;
-					const float OldYRange = OldYMax - OldYMin;
-					const float NewXRange = NewXMax - NewXMin;
-					const float NewYRange = NewYMax - NewYMin;
-
-					for (FBlendSample& Sample : *SampleData)
+					TArray<FBlendSample>* SampleData = SampleDataProperty->ContainerPtrToValuePtr<TArray<FBlendSample>>(BlendSpace);
+					if (SampleData)
 					{
-						// Normalize to 0-1 range based on old axis
-						const float NormX = (OldXRange != 0.f) ? (Sample.SampleValue.X - OldXMin) / OldXRange : 0.f;
-						const float NormY = (OldYRange != 0.f) ? (Sample.SampleValue.Y - OldYMin) / OldYRange : 0.f;
+						const float OldXRange = OldXMax - OldXMin;
+						const float OldYRange = OldYMax - OldYMin;
+						const float NewXRange = NewXMax - NewXMin;
+						const float NewYRange = NewYMax - NewYMin;
 
-						// Map to new range
-						Sample.SampleValue.X = NewXMin + NormX * NewXRange;
-						Sample.SampleValue.Y = NewYMin + NormY * NewYRange;
+						for (FBlendSample& Sample : *SampleData)
+						{
+							// Normalize to 0-1 range based on old axis
+							const float NormX = (OldXRange != 0.f) ? (Sample.SampleValue.X - OldXMin) / OldXRange : 0.f;
+							const float NormY = (OldYRange != 0.f) ? (Sample.SampleValue.Y - OldYMin) / OldYRange : 0.f;
+
+							// Map to new range
+							Sample.SampleValue.X = NewXMin + NormX * NewXRange;
+							Sample.SampleValue.Y = NewYMin + NormY * NewYRange;
+						}
 					}
 				}
-			}
 
-			// Access BlendParameters via reflection (protected member)
-			FProperty* BlendParametersProperty = UBlendSpace::StaticClass()->FindPropertyByName(TEXT("BlendParameters"));
-			if (!BlendParametersProperty)
-			{
-				continue;
-			}
+				// Access BlendParameters via reflection (protected member)
+				FProperty* BlendParametersProperty = UBlendSpace::StaticClass()->FindPropertyByName(TEXT("BlendParameters"));
+				if (!BlendParametersProperty)
+				{
+					return;
+				}
 
-			FBlendParameter* BlendParameters = BlendParametersProperty->ContainerPtrToValuePtr<FBlendParameter>(BlendSpace);
-			if (!BlendParameters)
-			{
-				continue;
-			}
+				FBlendParameter* BlendParameters = BlendParametersProperty->ContainerPtrToValuePtr<FBlendParameter>(BlendSpace);
+				if (!BlendParameters)
+				{
+					return;
+				}
 
-			// Update X axis
-			BlendParameters[0].Min = NewXMin;
-			BlendParameters[0].Max = NewXMax;
+				// Update X axis
+				BlendParameters[0].Min = NewXMin;
+				BlendParameters[0].Max = NewXMax;
 
-			// Update Y axis
-			BlendParameters[1].Min = NewYMin;
-			BlendParameters[1].Max = NewYMax;
+				// Update Y axis
+				BlendParameters[1].Min = NewYMin;
+				BlendParameters[1].Max = NewYMax;
 
-			// Validate sample data after modification
-			BlendSpace->ValidateSampleData();
+				// Validate sample data after modification
+				BlendSpace->ValidateSampleData();
 
-			// Mark package dirty
-			BlendSpace->MarkPackageDirty();
-			ModifiedCount++;
+				// Mark package dirty
+				BlendSpace->MarkPackageDirty();
+				(*ModifiedCount)++;
+			});
 		}
 
-		// Show notification
-		FNotificationInfo Notification(FText::Format(
-			LOCTEXT("AxisRangeAdjusted", "Adjusted axis range for {0} BlendSpace(s)"),
-			FText::AsNumber(ModifiedCount)));
-		Notification.ExpireDuration = 3.0f;
-		FSlateNotificationManager::Get().AddNotification(Notification);
+		Executor->OnCompleted().BindLambda([ModifiedCount](bool bCancelled)
+		{
+			// Show notification
+			FNotificationInfo Notification(FText::Format(
+				LOCTEXT("AxisRangeAdjusted", "Adjusted axis range for {0} BlendSpace(s)"),
+				FText::AsNumber(*ModifiedCount)));
+			Notification.ExpireDuration = 3.0f;
+			FSlateNotificationManager::Get().AddNotification(Notification);
+		});
+		Executor->Start();
 	}
 }
 
@@ -665,64 +832,74 @@ void FBlendSpaceBuilderModule::ExecuteConvertToGaitBased(TArray<FAssetData> Sele
 		return;
 	}
 
-	if (SpeedBasedBlendSpaces.Num() == 1)
-	{
-		// Single selection: show dialog
-		UBlendSpace* TargetBlendSpace = SpeedBasedBlendSpaces[0];
+	// Preview every selected BlendSpace; the dialog converts the approved ones in one batch
+	TSharedRef<SWindow> Window = SNew(SWindow)
+		.Title(LOCTEXT("ConvertToGaitBasedTitle", "Convert to Gait-Based BlendSpace"))
+		.ClientSize(SpeedBasedBlendSpaces.Num() > 1 ? FVector2D(700, 600) : FVector2D(500, 500))
+		.SupportsMinimize(false)
+		.SupportsMaximize(false);
 
-		TSharedRef<SWindow> Window = SNew(SWindow)
-			.Title(LOCTEXT("ConvertToGaitBasedTitle", "Convert to Gait-Based BlendSpace"))
-			.ClientSize(FVector2D(500, 500))
-			.SupportsMinimize(false)
-			.SupportsMaximize(false);
+	TSharedRef<SBlendSpaceGaitConversionDialog> Dialog = SNew(SBlendSpaceGaitConversionDialog)
+		.BlendSpaces(SpeedBasedBlendSpaces)
+		.ParentWindow(Window);
 
-		TSharedRef<SBlendSpaceGaitConversionDialog> Dialog = SNew(SBlendSpaceGaitConversionDialog)
-			.BlendSpace(TargetBlendSpace)
-			.ParentWindow(Window);
+	Window->SetContent(Dialog);
 
-		Window->SetContent(Dialog);
+	// Add as non-modal window
+	FSlateApplication::Get().AddWindow(Window);
+}
 
-		// Add as non-modal window
-		FSlateApplication::Get().AddWindow(Window);
-	}
-	else
-	{
-		// Multiple selection: batch convert with default settings
-		FGaitConversionConfig Config;
-		Config.bCreateCopy = false;
-		Config.bOpenInEditor = false;
+//=============================================================================
+// Segment Locomotion Take
+//=============================================================================
 
-		int32 SuccessCount = 0;
-		int32 FailCount = 0;
+void FBlendSpaceBuilderModule::CreateAnimSequenceMenu(FMenuBuilder& MenuBuilder, TArray<FAssetData> SelectedAssets)
+{
+	MenuBuilder.AddMenuEntry(
+		LOCTEXT("SegmentLocomotionTake", "Segment Locomotion Take"),
+		LOCTEXT("SegmentLocomotionTakeTooltip", "Scan a long mocap take and propose clip ranges per locomotion role (results in the Output Log)"),
+		FSlateIcon(FAppStyle::GetAppStyleSetName(), "ClassIcon.AnimSequence"),
+		FUIAction(FExecuteAction::CreateRaw(this, &FBlendSpaceBuilderModule::ExecuteSegmentLocomotionTake, SelectedAssets))
+	);
+}
 
-		for (UBlendSpace* BlendSpace : SpeedBasedBlendSpaces)
+void FBlendSpaceBuilderModule::ExecuteSegmentLocomotionTake(TArray<FAssetData> SelectedAssets)
+{
+	TArray<UAnimSequence*> Takes;
+	for (const FAssetData& Asset : SelectedAssets)
+	{
+		if (Asset.AssetClassPath == UAnimSequence::StaticClass()->GetClassPathName())
 		{
-			FGaitConversionResult ConversionResult;
-			UBlendSpace* ConvertedBlendSpace = FBlendSpaceGaitConverter::ConvertToGaitBased(BlendSpace, Config, ConversionResult);
-
-			if (ConvertedBlendSpace)
-			{
-				SuccessCount++;
-			}
-			else
+			if (UAnimSequence* Take = Cast<UAnimSequence>(Asset.GetAsset()))
 			{
-				FailCount++;
+				Takes.Add(Take);
 			}
 		}
+	}
 
-		// Show notification
-		FNotificationInfo Info(FText::Format(
-			LOCTEXT("BatchConvertResult", "Converted {0} BlendSpace(s) to Gait-based ({1} failed)"),
-			FText::AsNumber(SuccessCount),
-			FText::AsNumber(FailCount)));
-		Info.ExpireDuration = 5.0f;
-		Info.bUseSuccessFailIcons = true;
-		TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info);
-		if (Notification.IsValid())
+	if (Takes.IsEmpty())
+	{
+		return;
+	}
+
+	int32 SegmentCount = 0;
+	{
+		FScopedSlowTask SlowTask(Takes.Num(), LOCTEXT("SegmentingTakes", "Segmenting locomotion takes..."));
+		SlowTask.MakeDialog();
+
+		for (UAnimSequence* Take : Takes)
 		{
-			Notification->SetCompletionState(FailCount == 0 ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+			SlowTask.EnterProgressFrame(1.f, FText::FromString(Take->GetName()));
+			SegmentCount += FLocomotionTakeSegmenter::SegmentTake(Take).Num();
 		}
 	}
+
+	FNotificationInfo Info(FText::Format(
+		LOCTEXT("SegmentedTakes", "Found {0} locomotion segment(s) in {1} take(s) (see Output Log)"),
+		FText::AsNumber(SegmentCount),
+		FText::AsNumber(Takes.Num())));
+	Info.ExpireDuration = 5.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
 }
 
 #undef LOCTEXT_NAMESPACE
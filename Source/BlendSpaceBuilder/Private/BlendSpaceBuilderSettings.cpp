@@ -21,6 +21,14 @@ UBlendSpaceBuilderSettings::UBlendSpaceBuilderSettings()
 	{
 		InitializeDefaultIgnorableSuffixes();
 	}
+	if (SpeedCurveNames.Num() == 0 && DistanceCurveNames.Num() == 0)
+	{
+		InitializeDefaultCurveNames();
+	}
+	if (LeftFootMarkerNames.Num() == 0)
+	{
+		InitializeDefaultFootMarkerNames();
+	}
 }
 
 void UBlendSpaceBuilderSettings::ResetToDefaultPatterns()
@@ -287,46 +295,60 @@ void UBlendSpaceBuilderSettings::InitializeDefaultFootPatterns()
 	RightFootBonePatterns.Add(TEXT("R_Foot"));
 }
 
+void UBlendSpaceBuilderSettings::InitializeDefaultFootMarkerNames()
+{
+	// FName comparison is case-insensitive
+	LeftFootMarkerNames.Empty();
+	LeftFootMarkerNames.Add(TEXT("L"));
+	LeftFootMarkerNames.Add(TEXT("Foot_L"));
+	LeftFootMarkerNames.Add(TEXT("LeftFoot"));
+	LeftFootMarkerNames.Add(TEXT("Footstep_L"));
+	LeftFootMarkerNames.Add(TEXT("FootstepL"));
+
+	RightFootMarkerNames.Empty();
+	RightFootMarkerNames.Add(TEXT("R"));
+	RightFootMarkerNames.Add(TEXT("Foot_R"));
+	RightFootMarkerNames.Add(TEXT("RightFoot"));
+	RightFootMarkerNames.Add(TEXT("Footstep_R"));
+	RightFootMarkerNames.Add(TEXT("FootstepR"));
+}
+
 void UBlendSpaceBuilderSettings::ResetToDefaultFootPatterns()
 {
 	InitializeDefaultFootPatterns();
+	InitializeDefaultFootMarkerNames();
 	SaveConfig();
 }
 
-FName UBlendSpaceBuilderSettings::FindLeftFootBone(const USkeleton* Skeleton) const
+void UBlendSpaceBuilderSettings::InitializeDefaultCurveNames()
 {
-	if (!Skeleton)
-	{
-		return NAME_None;
-	}
-
-	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
-
-	for (int32 BoneIndex = 0; BoneIndex < RefSkeleton.GetNum(); ++BoneIndex)
-	{
-		FString BoneName = RefSkeleton.GetBoneName(BoneIndex).ToString();
-
-		// Skip IK bones - they don't have animation data
-		if (BoneName.Contains(TEXT("ik_"), ESearchCase::IgnoreCase) ||
-			BoneName.Contains(TEXT("_ik"), ESearchCase::IgnoreCase) ||
-			BoneName.StartsWith(TEXT("IK"), ESearchCase::CaseSensitive))
-		{
-			continue;
-		}
+	SpeedCurveNames.Empty();
+	SpeedCurveNames.Add(TEXT("Speed"));
+	SpeedCurveNames.Add(TEXT("MoveSpeed"));
+
+	// Written by distance matching modifiers
+	DistanceCurveNames.Empty();
+	DistanceCurveNames.Add(TEXT("Distance"));
+	DistanceCurveNames.Add(TEXT("DistanceCurve"));
+}
 
-		for (const FString& Pattern : LeftFootBonePatterns)
-		{
-			if (BoneName.Contains(Pattern, ESearchCase::IgnoreCase))
-			{
-				return RefSkeleton.GetBoneName(BoneIndex);
-			}
-		}
-	}
+void UBlendSpaceBuilderSettings::ResetToDefaultCurveNames()
+{
+	InitializeDefaultCurveNames();
+	SaveConfig();
+}
 
-	return NAME_None;
+FName UBlendSpaceBuilderSettings::FindLeftFootBone(const USkeleton* Skeleton) const
+{
+	return FindBoneByPatterns(Skeleton, LeftFootBonePatterns);
 }
 
 FName UBlendSpaceBuilderSettings::FindRightFootBone(const USkeleton* Skeleton) const
+{
+	return FindBoneByPatterns(Skeleton, RightFootBonePatterns);
+}
+
+FName UBlendSpaceBuilderSettings::FindBoneByPatterns(const USkeleton* Skeleton, const TArray<FString>& Patterns)
 {
 	if (!Skeleton)
 	{
@@ -347,7 +369,7 @@ FName UBlendSpaceBuilderSettings::FindRightFootBone(const USkeleton* Skeleton) c
 			continue;
 		}
 
-		for (const FString& Pattern : RightFootBonePatterns)
+		for (const FString& Pattern : Patterns)
 		{
 			if (BoneName.Contains(Pattern, ESearchCase::IgnoreCase))
 			{
@@ -385,6 +407,11 @@ void UBlendSpaceBuilderSettings::ResetToDefaultIgnorableSuffixes()
 }
 
 FString UBlendSpaceBuilderSettings::StripIgnorableSuffixes(const FString& AnimName) const
+{
+	return StripSuffixes(AnimName, IgnorableSuffixes);
+}
+
+FString UBlendSpaceBuilderSettings::StripSuffixes(const FString& AnimName, const TArray<FString>& Suffixes)
 {
 	FString Result = AnimName;
 
@@ -399,7 +426,7 @@ FString UBlendSpaceBuilderSettings::StripIgnorableSuffixes(const FString& AnimNa
 	}
 
 	// 2. Sort suffixes by length (longer first, so _RootMotion is checked before _RM)
-	TArray<FString> SortedSuffixes = IgnorableSuffixes;
+	TArray<FString> SortedSuffixes = Suffixes;
 	SortedSuffixes.Sort([](const FString& A, const FString& B)
 	{
 		return A.Len() > B.Len();
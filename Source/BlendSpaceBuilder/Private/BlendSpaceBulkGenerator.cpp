@@ -0,0 +1,446 @@
+#include "BlendSpaceBulkGenerator.h"
+#include "BlendSpaceBuilderSettings.h"
+#include "BlendSpaceTimeSlicedExecutor.h"
+#include "LocomotionAnimClassifier.h"
+
+#include "Animation/AnimSequence.h"
+#include "Animation/BlendSpace.h"
+#include "Animation/Skeleton.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Framework/Docking/TabManager.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "BlendSpaceBulkGenerator"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBlendSpaceBulkGenerator, Log, All);
+
+namespace BlendSpaceBulkGeneratorInternal
+{
+	// Skeletons classified and analyzing ahead of the one being created
+	constexpr int32 MaxJobsAhead = 2;
+
+	// Tier speeds stored as BlendSpace metadata, as the config dialog does
+	void SetAnalyzedSpeeds(FBlendSpaceBuildConfig& Config)
+	{
+		for (const auto& Pair : Config.SelectedAnimations)
+		{
+			const FVector* Position = Config.PreAnalyzedPositions.Find(Pair.Value);
+			const float Speed = Position ? Position->Size2D() : 0.f;
+			if (Pair.Key >= ELocomotionRole::WalkForward && Pair.Key <= ELocomotionRole::WalkBackwardRight)
+			{
+				Config.AnalyzedWalkSpeed = FMath::Max(Config.AnalyzedWalkSpeed, Speed);
+			}
+			else if (Pair.Key >= ELocomotionRole::RunForward && Pair.Key <= ELocomotionRole::RunBackwardRight)
+			{
+				Config.AnalyzedRunSpeed = FMath::Max(Config.AnalyzedRunSpeed, Speed);
+			}
+			else if (Pair.Key == ELocomotionRole::SprintForward)
+			{
+				Config.AnalyzedSprintSpeed = FMath::Max(Config.AnalyzedSprintSpeed, Speed);
+			}
+		}
+	}
+}
+
+TArray<FSoftObjectPath> FBlendSpaceBulkGenerator::FindSkeletonsInPaths(const TArray<FString>& FolderPaths)
+{
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(USkeleton::StaticClass()->GetClassPathName());
+	Filter.bRecursivePaths = true;
+	for (const FString& FolderPath : FolderPaths)
+	{
+		Filter.PackagePaths.Add(FName(*FolderPath));
+	}
+
+	TArray<FAssetData> AssetDataList;
+	AssetRegistry.GetAssets(Filter, AssetDataList);
+
+	TArray<FSoftObjectPath> SkeletonPaths;
+	for (const FAssetData& AssetData : AssetDataList)
+	{
+		SkeletonPaths.Add(AssetData.GetSoftObjectPath());
+	}
+
+	// Stable order regardless of registry enumeration
+	SkeletonPaths.Sort([](const FSoftObjectPath& A, const FSoftObjectPath& B) { return A.ToString() < B.ToString(); });
+	return SkeletonPaths;
+}
+
+TSharedRef<FBlendSpaceBulkGenerator> FBlendSpaceBulkGenerator::Start(const TArray<FSoftObjectPath>& SkeletonPaths)
+{
+	TSharedRef<FBlendSpaceBulkGenerator> Generator = MakeShared<FBlendSpaceBulkGenerator>(SkeletonPaths);
+	Generator->Begin();
+	return Generator;
+}
+
+FBlendSpaceBulkGenerator::FBlendSpaceBulkGenerator(const TArray<FSoftObjectPath>& SkeletonPaths)
+{
+	for (const FSoftObjectPath& SkeletonPath : SkeletonPaths)
+	{
+		Jobs.AddDefaulted();
+		FBlendSpaceBulkResult& Result = Results.AddDefaulted_GetRef();
+		Result.SkeletonPath = SkeletonPath;
+	}
+}
+
+void FBlendSpaceBulkGenerator::Begin()
+{
+	check(IsInGameThread());
+
+	// Clips are analyzed once at full precision; Auto picks root motion or foot analysis per clip
+	AnalysisOptions.AnalysisType = EBlendSpaceAnalysisType::Auto;
+	AnalysisOptions.Quality = EBlendSpaceAnalysisQuality::Exact;
+	AnalysisOptions.SettingsSnapshot = FBlendSpaceAnalysisSettings::Capture();
+	MemoryWindow = MakeUnique<FBlendSpaceMemoryWindow>();
+
+	TSharedRef<FBlendSpaceBulkGenerator> This = AsShared();
+	FNotificationInfo Info(LOCTEXT("BulkGenerating", "Generating locomotion BlendSpaces"));
+	Info.Text = TAttribute<FText>::CreateSP(This, &FBlendSpaceBulkGenerator::GetProgressText);
+	Info.bFireAndForget = false;
+	Info.bUseThrobber = true;
+	Info.bUseSuccessFailIcons = true;
+	Info.ButtonDetails.Add(FNotificationButtonInfo(
+		LOCTEXT("Cancel", "Cancel"),
+		LOCTEXT("CancelTip", "Stop after the BlendSpace being created"),
+		FSimpleDelegate::CreateSP(This, &FBlendSpaceBulkGenerator::Cancel),
+		SNotificationItem::CS_Pending));
+	Notification = FSlateNotificationManager::Get().AddNotification(Info);
+	if (TSharedPtr<SNotificationItem> Item = Notification.Pin())
+	{
+		Item->SetCompletionState(SNotificationItem::CS_Pending);
+	}
+
+	// The ticker holds the generator until every skeleton is done
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([This](float DeltaTime)
+	{
+		return This->Tick(DeltaTime);
+	}));
+}
+
+void FBlendSpaceBulkGenerator::Cancel()
+{
+	bCancelled = true;
+	if (CreationExecutor.IsValid())
+	{
+		CreationExecutor->Cancel();
+	}
+}
+
+bool FBlendSpaceBulkGenerator::Tick(float DeltaTime)
+{
+	using namespace BlendSpaceBulkGeneratorInternal;
+
+	// Finished skeletons are saved and unreferenced; skeletons in flight stay referenced by their jobs
+	if (!CreationExecutor.IsValid() && MemoryWindow->IsOverBudget())
+	{
+		// Packages still being written are not released under the writer
+		Saver.Wait();
+		MemoryWindow->Release();
+	}
+
+	// Classification loads animations, so only one skeleton is prepared per tick
+	if (!bCancelled && NextJobToPrepare < Jobs.Num() && NextJobToPrepare - NextJobToCreate < MaxJobsAhead)
+	{
+		PrepareJob(NextJobToPrepare++);
+	}
+
+	// Creation runs in skeleton order, one at a time, once its analysis is complete
+	while (!CreationExecutor.IsValid() && NextJobToCreate < NextJobToPrepare)
+	{
+		FJob& Job = Jobs[NextJobToCreate];
+		if (Job.Stage == EStage::Analyzing)
+		{
+			if (!Job.AnalysisTask.IsCompleted())
+			{
+				break;
+			}
+			if (bCancelled)
+			{
+				FinishJob(NextJobToCreate, false, TEXT("Cancelled"));
+			}
+			else
+			{
+				CreateJob(NextJobToCreate);
+			}
+		}
+		++NextJobToCreate;
+	}
+
+	if (bCancelled && !CreationExecutor.IsValid())
+	{
+		// Analyses already launched still read their animations; wait for them before releasing references
+		for (int32 JobIndex = NextJobToCreate; JobIndex < NextJobToPrepare; ++JobIndex)
+		{
+			if (Jobs[JobIndex].Stage == EStage::Analyzing && !Jobs[JobIndex].AnalysisTask.IsCompleted())
+			{
+				return true;
+			}
+		}
+		for (int32 JobIndex = 0; JobIndex < Jobs.Num(); ++JobIndex)
+		{
+			if (Jobs[JobIndex].Stage != EStage::Done)
+			{
+				FinishJob(JobIndex, false, TEXT("Cancelled"));
+			}
+		}
+	}
+
+	if (NumJobsDone == Jobs.Num())
+	{
+		Finish();
+		return false;
+	}
+	return true;
+}
+
+void FBlendSpaceBulkGenerator::PrepareJob(int32 JobIndex)
+{
+	using namespace BlendSpaceBulkGeneratorInternal;
+
+	FJob& Job = Jobs[JobIndex];
+	const UBlendSpaceBuilderSettings* Settings = UBlendSpaceBuilderSettings::Get();
+
+	// The skeleton and the animations classification loads belong to the batch's memory window
+	FBlendSpaceMemoryWindow::FLoadScope LoadScope(*MemoryWindow);
+
+	// Discovery
+	Job.Skeleton = Cast<USkeleton>(Results[JobIndex].SkeletonPath.TryLoad());
+	if (!Job.Skeleton)
+	{
+		FinishJob(JobIndex, false, TEXT("Skeleton could not be loaded"));
+		return;
+	}
+
+	FBlendSpaceBuildConfig& Config = Job.Config;
+	Config.Skeleton = Job.Skeleton;
+	Config.PackagePath = FPackageName::GetLongPackagePath(Job.Skeleton->GetOutermost()->GetName());
+	Config.AssetName = Job.Skeleton->GetName() + Settings->OutputAssetSuffix;
+	Config.XAxisName = Settings->XAxisName;
+	Config.YAxisName = Settings->YAxisName;
+	Config.AnalysisType = AnalysisOptions.AnalysisType;
+	Config.LeftFootBoneName = Settings->FindLeftFootBone(Job.Skeleton);
+	Config.RightFootBoneName = Settings->FindRightFootBone(Job.Skeleton);
+	Config.bOpenInEditor = false;
+	Config.bDeferSave = true;
+
+	// Existing assets are never overwritten
+	const FSoftObjectPath TargetPath(Config.PackagePath / Config.AssetName + TEXT(".") + Config.AssetName);
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	if (AssetRegistryModule.Get().GetAssetByObjectPath(TargetPath).IsValid())
+	{
+		FinishJob(JobIndex, false, FString::Printf(TEXT("%s already exists"), *TargetPath.ToString()));
+		return;
+	}
+
+	// Classification: recommended candidate per role, as the dialog preselects
+	FLocomotionAnimClassifier Classifier;
+	Classifier.FindAnimationsForSkeleton(Job.Skeleton);
+	Classifier.ClassifyAnimations();
+	for (const auto& Pair : Classifier.GetClassifiedResults())
+	{
+		if (const FClassifiedAnimation* Recommended = Pair.Value.GetRecommended(Settings->bPreferRootMotionAnimations))
+		{
+			if (UAnimSequence* Anim = Recommended->Animation.Get())
+			{
+				Config.SelectedAnimations.Add(Pair.Key, Anim);
+			}
+		}
+	}
+
+	if (Config.SelectedAnimations.Num() == 0)
+	{
+		FinishJob(JobIndex, false, TEXT("No locomotion animations found"));
+		return;
+	}
+
+	// Analysis and axis range off the game thread
+	FBlendSpaceAnalysisOptions Options = AnalysisOptions;
+	Options.LeftFootBone = Config.LeftFootBoneName;
+	Options.RightFootBone = Config.RightFootBoneName;
+
+	// Skeletons imported at another unit scale are normalized from their leg length, as the dialog does by default
+	const float ScaleDivisor = FBlendSpaceFactory::GetAutoScaleDivisor(Job.Skeleton);
+
+	const TMap<ELocomotionRole, UAnimSequence*> Animations = Config.SelectedAnimations;
+	const int32 GridDivisions = Config.GridDivisions;
+	Job.AnalysisTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Animations, Options, GridDivisions, ScaleDivisor]()
+	{
+		FAnalysisOutput Output;
+		Output.Results = FBlendSpaceFactory::AnalyzeSamples(Animations, Options);
+
+		TMap<UAnimSequence*, FVector> Positions;
+		for (auto& Pair : Output.Results)
+		{
+			if (ScaleDivisor > KINDA_SMALL_NUMBER && ScaleDivisor != 1.0f)
+			{
+				Pair.Value.Velocity /= ScaleDivisor;
+				Pair.Value.Position /= ScaleDivisor;
+				Pair.Value.ErrorEstimate /= ScaleDivisor;
+			}
+			Positions.Add(Pair.Key, Pair.Value.Position);
+		}
+		FBlendSpaceFactory::CalculateAxisRangeFromAnalysis(Positions, GridDivisions, false,
+			Output.XAxisMin, Output.XAxisMax, Output.YAxisMin, Output.YAxisMax);
+		return Output;
+	}, LowLevelTasks::ETaskPriority::BackgroundNormal);
+	Job.Stage = EStage::Analyzing;
+}
+
+void FBlendSpaceBulkGenerator::CreateJob(int32 JobIndex)
+{
+	using namespace BlendSpaceBulkGeneratorInternal;
+
+	FJob& Job = Jobs[JobIndex];
+	const FAnalysisOutput& Output = Job.AnalysisTask.GetResult();
+
+	FBlendSpaceBuildConfig& Config = Job.Config;
+	for (const auto& Pair : Output.Results)
+	{
+		Config.PreAnalyzedPositions.Add(Pair.Key, Pair.Value.Position);
+	}
+	Config.bApplyAnalysis = true;
+	Config.XAxisMin = Output.XAxisMin;
+	Config.XAxisMax = Output.XAxisMax;
+	Config.YAxisMin = Output.YAxisMin;
+	Config.YAxisMax = Output.YAxisMax;
+	SetAnalyzedSpeeds(Config);
+
+	// Creation and save are spread over editor frames while the next skeletons analyze
+	CreationExecutor = MakeShared<FBlendSpaceTimeSlicedExecutor>(FText::FromString(Config.AssetName));
+	CreationExecutor->SetShowNotification(false);
+	Job.Stage = EStage::Creating;
+
+	TWeakPtr<FBlendSpaceBulkGenerator> WeakGenerator = AsShared();
+	const int32 NumSamples = Config.SelectedAnimations.Num();
+	FBlendSpaceFactory::QueueLocomotionBlendSpaceCreation(*CreationExecutor, Config, [WeakGenerator, JobIndex, NumSamples](UBlendSpace* BlendSpace)
+	{
+		if (TSharedPtr<FBlendSpaceBulkGenerator> Generator = WeakGenerator.Pin())
+		{
+			if (BlendSpace)
+			{
+				Generator->Results[JobIndex].BlendSpacePath = FSoftObjectPath(BlendSpace);
+				Generator->Results[JobIndex].NumSamples = NumSamples;
+				Generator->MemoryWindow->AddPackage(BlendSpace->GetOutermost());
+				Generator->Saver.Add(BlendSpace);
+				Generator->Saver.SavePending();
+			}
+			Generator->FinishJob(JobIndex, BlendSpace != nullptr, BlendSpace ? FString() : TEXT("BlendSpace could not be created"));
+		}
+	});
+	CreationExecutor->OnCompleted().BindLambda([WeakGenerator, JobIndex](bool bExecutorCancelled)
+	{
+		if (TSharedPtr<FBlendSpaceBulkGenerator> Generator = WeakGenerator.Pin())
+		{
+			if (Generator->Jobs[JobIndex].Stage != EStage::Done)
+			{
+				Generator->FinishJob(JobIndex, false, TEXT("Cancelled"));
+			}
+			Generator->CreationExecutor.Reset();
+		}
+	});
+	CreationExecutor->Start();
+}
+
+void FBlendSpaceBulkGenerator::FinishJob(int32 JobIndex, bool bSucceeded, const FString& Message)
+{
+	FJob& Job = Jobs[JobIndex];
+	if (Job.Stage == EStage::Done)
+	{
+		return;
+	}
+
+	Job.Stage = EStage::Done;
+	Results[JobIndex].bSucceeded = bSucceeded;
+	Results[JobIndex].Message = Message;
+	++NumJobsDone;
+
+	// Release the animations of finished skeletons
+	Job.Config.SelectedAnimations.Empty();
+	Job.Config.PreAnalyzedPositions.Empty();
+	Job.AnalysisTask = {};
+}
+
+void FBlendSpaceBulkGenerator::Finish()
+{
+	TickerHandle.Reset();
+	MemoryWindow.Reset();
+	Saver.Wait();
+
+	int32 NumSucceeded = 0;
+	int32 NumSkipped = 0;
+	for (const FBlendSpaceBulkResult& Result : Results)
+	{
+		if (Result.bSucceeded)
+		{
+			++NumSucceeded;
+			UE_LOG(LogBlendSpaceBulkGenerator, Log, TEXT("%s: created %s (%d samples)"),
+				*Result.SkeletonPath.ToString(), *Result.BlendSpacePath.ToString(), Result.NumSamples);
+		}
+		else
+		{
+			++NumSkipped;
+			UE_LOG(LogBlendSpaceBulkGenerator, Warning, TEXT("%s: skipped (%s)"),
+				*Result.SkeletonPath.ToString(), *Result.Message);
+		}
+	}
+
+	const FText Summary = FText::Format(
+		LOCTEXT("BulkResult", "Generated {0} locomotion BlendSpace(s) for {1} skeleton(s) ({2} skipped)"),
+		FText::AsNumber(NumSucceeded),
+		FText::AsNumber(Results.Num()),
+		FText::AsNumber(NumSkipped));
+	UE_LOG(LogBlendSpaceBulkGenerator, Log, TEXT("%s"), *Summary.ToString());
+	UE_LOG(LogBlendSpaceBulkGenerator, Log, TEXT("Packages: %d written, %d unchanged, %d failed"),
+		Saver.GetNumWritten(), Saver.GetNumUnchanged(), Saver.GetNumFailed());
+
+	if (TSharedPtr<SNotificationItem> Item = Notification.Pin())
+	{
+		Item->SetText(Summary);
+		Item->SetCompletionState(NumSkipped == 0 ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		Item->ExpireAndFadeout();
+	}
+
+	// Per-skeleton details are in the output log
+	if (NumSkipped > 0)
+	{
+		FNotificationInfo Info(LOCTEXT("BulkSkippedDetails", "Some skeletons were skipped"));
+		Info.ExpireDuration = 8.0f;
+		Info.Hyperlink = FSimpleDelegate::CreateLambda([]()
+		{
+			FGlobalTabmanager::Get()->TryInvokeTab(FName("OutputLog"));
+		});
+		Info.HyperlinkText = LOCTEXT("ShowOutputLog", "Show Output Log");
+		FSlateNotificationManager::Get().AddNotification(Info);
+	}
+}
+
+FText FBlendSpaceBulkGenerator::GetProgressText() const
+{
+	return FText::Format(
+		LOCTEXT("BulkProgress", "Generating locomotion BlendSpaces ({0} / {1} skeletons)"),
+		FText::AsNumber(NumJobsDone),
+		FText::AsNumber(Jobs.Num()));
+}
+
+void FBlendSpaceBulkGenerator::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (FJob& Job : Jobs)
+	{
+		if (Job.Stage == EStage::Done)
+		{
+			continue;
+		}
+
+		Collector.AddReferencedObject(Job.Skeleton);
+		for (auto& Pair : Job.Config.SelectedAnimations)
+		{
+			Collector.AddReferencedObject(Pair.Value);
+		}
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
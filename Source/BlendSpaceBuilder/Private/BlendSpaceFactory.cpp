@@ -1,17 +1,29 @@
 #include "BlendSpaceFactory.h"
+#include "BlendSpaceAnalysisInternal.h"
+#include "BlendSpaceAnalysisCache.h"
+#include "BlendSpaceAnalysisDerivedData.h"
 #include "BlendSpaceBuilderSettings.h"
 #include "BlendSpaceConfigAssetUserData.h"
+#include "BlendSpaceTimeSlicedExecutor.h"
+#include "BlendSpacePackageSaver.h"
 
 #include "Animation/BlendSpace.h"
 #include "Animation/AnimationAsset.h"
 #include "Animation/AnimSequence.h"
 #include "Animation/AnimTypes.h"
+#include "Animation/AnimCurveTypes.h"
+#include "Animation/AnimData/IAnimationDataModel.h"
+#include "Animation/MirrorDataTable.h"
 #include "Animation/Skeleton.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Tasks/Task.h"
 #include "AssetToolsModule.h"
 #include "IAssetTools.h"
 #include "UObject/Package.h"
-#include "UObject/SavePackage.h"
+#include "ObjectTools.h"
+#include "PackageTools.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "UObject/UnrealType.h"
@@ -26,6 +38,8 @@ DEFINE_LOG_CATEGORY_STATIC(LogBlendSpaceBuilder, Log, All);
 // Internal helper functions for analysis
 //=============================================================================
 
+FVector2D GetRoleDirectionSign(ELocomotionRole Role);
+
 namespace BlendSpaceAnalysisInternal
 {
 	// Get a "nice" step size for axis range (rounds to 1, 2, 2.5, 5 * 10^n pattern)
@@ -56,39 +70,22 @@ namespace BlendSpaceAnalysisInternal
 		return Magnitude * 10.f;
 	}
 
-	// Calculate component space transform by traversing parent chain
-	FTransform GetComponentSpaceTransform(
-		const UAnimSequence* Animation,
-		const FReferenceSkeleton& RefSkeleton,
-		int32 BoneIndex,
-		double Time)
+	// Root motion velocity from a single extraction over the whole clip, without threshold checks
+	FVector ProbeRootMotionVelocity(const UAnimSequence* Animation)
 	{
-		TArray<FTransform> BoneTransforms;
-
-		// Collect all bone transforms from target to root
-		int32 CurrentBone = BoneIndex;
-		while (CurrentBone != INDEX_NONE)
-		{
-			FTransform BoneLocalTM;
-			FAnimExtractContext ExtractContext(Time);
-			Animation->GetBoneTransform(BoneLocalTM, FSkeletonPoseBoneIndex(CurrentBone), ExtractContext, false);
-			BoneTransforms.Add(BoneLocalTM);
-			CurrentBone = RefSkeleton.GetParentIndex(CurrentBone);
-		}
-
-		// Compose transforms from root to target
-		FTransform ComponentSpaceTM = FTransform::Identity;
-		for (int32 i = BoneTransforms.Num() - 1; i >= 0; --i)
+		const double PlayLength = Animation->GetPlayLength();
+		if (PlayLength <= KINDA_SMALL_NUMBER)
 		{
-			ComponentSpaceTM = BoneTransforms[i] * ComponentSpaceTM;
+			return FVector::ZeroVector;
 		}
 
-		return ComponentSpaceTM;
+		const FTransform RootMotion = Animation->ExtractRootMotionFromRange(0.0, PlayLength, FAnimExtractContext());
+		return RootMotion.GetTranslation() / PlayLength * Animation->RateScale;
 	}
 
 	// Calculate root motion velocity from animation
 	// Returns FVector(RightVelocity, ForwardVelocity, 0)
-	FVector CalculateRootMotionVelocity(const UAnimSequence* Animation)
+	FVector CalculateRootMotionVelocity(const UAnimSequence* Animation, const FBlendSpaceAnalysisSettings& Settings)
 	{
 		if (!Animation)
 		{
@@ -103,16 +100,11 @@ namespace BlendSpaceAnalysisInternal
 			return FVector::ZeroVector;
 		}
 
-		// Extract root motion from start to end of animation
-		FTransform RootMotion = Animation->ExtractRootMotionFromRange(0.0, PlayLength, FAnimExtractContext());
-		FVector Translation = RootMotion.GetTranslation();
-		FVector Velocity = Translation / PlayLength;
-
-		// Apply rate scale
-		Velocity *= Animation->RateScale;
+		// Extract root motion from start to end of animation (rate scale applied)
+		FVector Velocity = ProbeRootMotionVelocity(Animation);
 
 		// Check if velocity is below threshold (root motion enabled but no actual movement)
-		const float MinVelocity = UBlendSpaceBuilderSettings::Get()->MinVelocityThreshold;
+		const float MinVelocity = Settings.MinVelocityThreshold;
 		const float Speed2D = FVector2D(Velocity.X, Velocity.Y).Size();
 		if (Speed2D < MinVelocity)
 		{
@@ -129,183 +121,1299 @@ namespace BlendSpaceAnalysisInternal
 		return FVector(Velocity.X, Velocity.Y, 0.f);
 	}
 
-	// Helper: Collect foot positions from animation
-	bool CollectFootPositions(
-		const UAnimSequence* Animation,
-		FName FootBoneName,
-		TArray<FVector>& OutPositions,
-		double& OutDeltaTime)
+	// Calculate reference pose component space transform by traversing parent chain
+	FTransform GetRefPoseComponentSpaceTransform(const FReferenceSkeleton& RefSkeleton, int32 BoneIndex)
+	{
+		const TArray<FTransform>& RefBonePose = RefSkeleton.GetRefBonePose();
+
+		FTransform ComponentSpaceTM = FTransform::Identity;
+		int32 CurrentBone = BoneIndex;
+		while (CurrentBone != INDEX_NONE)
+		{
+			ComponentSpaceTM = ComponentSpaceTM * RefBonePose[CurrentBone];
+			CurrentBone = RefSkeleton.GetParentIndex(CurrentBone);
+		}
+
+		return ComponentSpaceTM;
+	}
+
+	// Helper: Validate animation and resolve contact bone indices for locomotion analysis
+	// Bones missing from the skeleton are skipped; fails when none resolve
+	bool ResolveContactBones(
+		const UAnimSequence* Animation,
+		const TArray<FName>& ContactBoneNames,
+		TArray<int32>& OutBoneIndices,
+		TArray<FName>& OutBoneNames,
+		int32& OutNumKeys)
+	{
+		if (!Animation || ContactBoneNames.Num() == 0)
+		{
+			UE_LOG(LogBlendSpaceBuilder, Warning, TEXT("Locomotion: Invalid input (Anim=%s, %d contact bones)"),
+				Animation ? *Animation->GetName() : TEXT("null"), ContactBoneNames.Num());
+			return false;
+		}
+
+		OutNumKeys = Animation->GetNumberOfSampledKeys();
+		if (OutNumKeys <= 1)
+		{
+			UE_LOG(LogBlendSpaceBuilder, Warning, TEXT("Locomotion: '%s' has insufficient keys (%d)"),
+				*Animation->GetName(), OutNumKeys);
+			return false;
+		}
+
+		USkeleton* Skeleton = Animation->GetSkeleton();
+		if (!Skeleton)
+		{
+			UE_LOG(LogBlendSpaceBuilder, Warning, TEXT("Locomotion: '%s' has no skeleton"),
+				*Animation->GetName());
+			return false;
+		}
+
+		const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+		for (FName BoneName : ContactBoneNames)
+		{
+			const int32 BoneIndex = RefSkeleton.FindBoneIndex(BoneName);
+			if (BoneIndex == INDEX_NONE)
+			{
+				UE_LOG(LogBlendSpaceBuilder, Warning, TEXT("Locomotion: '%s' contact bone '%s' not found in skeleton"),
+					*Animation->GetName(), *BoneName.ToString());
+				continue;
+			}
+			if (!OutBoneIndices.Contains(BoneIndex))
+			{
+				OutBoneIndices.Add(BoneIndex);
+				OutBoneNames.Add(BoneName);
+			}
+		}
+
+		return OutBoneIndices.Num() > 0;
+	}
+
+	// Key subsampling derived from an analysis quality preset
+	struct FKeySampling
+	{
+		/** Evaluate every KeyStep-th key */
+		int32 KeyStep = 1;
+
+		/** Also run a shadow estimate at 2 * KeyStep to estimate the subsampling error */
+		bool bEstimateError = false;
+	};
+
+	FKeySampling GetKeySampling(const UAnimSequence* Animation, EBlendSpaceAnalysisQuality Quality)
+	{
+		FKeySampling Sampling;
+		if (!Animation || Quality == EBlendSpaceAnalysisQuality::Exact)
+		{
+			return Sampling;
+		}
+
+		const double PlayLength = Animation->GetPlayLength();
+		const int32 NumKeys = Animation->GetNumberOfSampledKeys();
+		if (PlayLength <= KINDA_SMALL_NUMBER || NumKeys <= 1)
+		{
+			return Sampling;
+		}
+
+		// Fixed sample rates (Hz) for the subsampled presets
+		const double TargetSampleRate = (Quality == EBlendSpaceAnalysisQuality::Fast) ? 10.0 : 30.0;
+		const double KeyRate = NumKeys / PlayLength;
+
+		// Keep at least 4 evaluated keys so the shadow estimate still has a difference to measure
+		const int32 MaxStep = FMath::Max(1, (NumKeys - 1) / 4);
+		Sampling.KeyStep = FMath::Clamp(FMath::FloorToInt32(KeyRate / TargetSampleRate), 1, MaxStep);
+		// A step of 1 evaluates every key, which is the exact result and has nothing to estimate
+		Sampling.bEstimateError = Sampling.KeyStep > 1;
+		return Sampling;
+	}
+
+	// Velocity estimate at the requested sampling, plus a shadow estimate at half the sampling rate
+	struct FVelocityEstimate
+	{
+		FVector Velocity = FVector::ZeroVector;
+		FVector CoarseVelocity = FVector::ZeroVector;
+		int32 NumKeysEvaluated = 0;
+
+		// Magnitude difference between the two sampling rates (cm/s)
+		float GetErrorEstimate(const FKeySampling& Sampling) const
+		{
+			return Sampling.bEstimateError
+				? FMath::Abs(float(Velocity.Size2D() - CoarseVelocity.Size2D()))
+				: 0.f;
+		}
+	};
+
+	// Evaluated keys per analysis block. Long clips evaluate bone positions as fixed blocks of keys on
+	// parallel tasks; the positions are then accumulated serially in key order, exactly as a single-threaded
+	// pass would, so results are bit-identical however blocks are scheduled.
+	constexpr int32 AnalysisBlockKeys = 128;
+
+	// Evaluated keys buffered per pass, which bounds the positions held for long clips
+	constexpr int32 AnalysisPassKeys = 64 * AnalysisBlockKeys;
+
+	// Number of analysis blocks covering NumSamples evaluated keys
+	int32 GetNumAnalysisBlocks(int32 NumSamples)
+	{
+		return FMath::DivideAndRoundUp(NumSamples, AnalysisBlockKeys);
+	}
+
+	// Streaming foot velocity estimator that only integrates ground contact phases.
+	// Keys are fed in time order and only the previous key plus running sums are kept,
+	// so memory stays O(1) regardless of clip length.
+	// A foot counts as planted when it is within HeightTolerance of the ground height and
+	// barely moving vertically. Horizontal speed is not used: in an in-place clip the planted
+	// foot slides backward at character speed in component space.
+	struct FContactPhaseVelocityEstimator
+	{
+		FContactPhaseVelocityEstimator(double InGroundHeight, double InHeightTolerance, double InMaxVerticalSpeed)
+			: GroundHeight(InGroundHeight)
+			, HeightTolerance(InHeightTolerance)
+			, MaxVerticalSpeed(InMaxVerticalSpeed)
+		{
+		}
+
+		void AddKey(const FVector& Position, double Time)
+		{
+			if (NumKeys > 0)
+			{
+				AccumulateStep(PrevPosition, PrevTime, Position, Time);
+			}
+
+			PrevPosition = Position;
+			PrevTime = Time;
+			++NumKeys;
+		}
+
+		bool HasContact() const
+		{
+			return PlantedTime > KINDA_SMALL_NUMBER;
+		}
+
+		// Foot velocity averaged over planted phases only
+		FVector GetContactVelocity() const
+		{
+			return HasContact() ? PlantedDisplacement / PlantedTime : FVector::ZeroVector;
+		}
+
+		// Foot velocity averaged over every key (last velocity repeated for the final key)
+		FVector GetAverageVelocity() const
+		{
+			return (NumKeys > 1) ? (VelocitySum + LastVelocity) / NumKeys : FVector::ZeroVector;
+		}
+
+		// Contact velocity, or the all-keys average when no contact phase was detected
+		FVector GetVelocity() const
+		{
+			return HasContact() ? GetContactVelocity() : GetAverageVelocity();
+		}
+
+		double GetPlantedTime() const
+		{
+			return PlantedTime;
+		}
+
+	private:
+		void AccumulateStep(const FVector& FromPosition, double FromTime, const FVector& ToPosition, double ToTime)
+		{
+			const double DeltaTime = ToTime - FromTime;
+			if (DeltaTime <= KINDA_SMALL_NUMBER)
+			{
+				return;
+			}
+
+			const FVector Displacement = ToPosition - FromPosition;
+			LastVelocity = Displacement / DeltaTime;
+			VelocitySum += LastVelocity;
+
+			const bool bNearGround = ToPosition.Z <= GroundHeight + HeightTolerance
+				&& FromPosition.Z <= GroundHeight + HeightTolerance;
+			const bool bVerticallyStill = FMath::Abs(LastVelocity.Z) <= MaxVerticalSpeed;
+			if (bNearGround && bVerticallyStill)
+			{
+				PlantedDisplacement += Displacement;
+				PlantedTime += DeltaTime;
+			}
+		}
+
+		double GroundHeight = 0.0;
+		double HeightTolerance = 0.0;
+		double MaxVerticalSpeed = 0.0;
+
+		FVector PrevPosition = FVector::ZeroVector;
+		double PrevTime = 0.0;
+		int32 NumKeys = 0;
+
+		FVector LastVelocity = FVector::ZeroVector;
+		FVector VelocitySum = FVector::ZeroVector;
+		FVector PlantedDisplacement = FVector::ZeroVector;
+		double PlantedTime = 0.0;
+	};
+
+	// Streaming min/max extents of a foot trajectory on the horizontal plane
+	struct FFootExtents
+	{
+		double MinX = DBL_MAX, MaxX = -DBL_MAX;
+		double MinY = DBL_MAX, MaxY = -DBL_MAX;
+
+		void Add(const FVector& Position)
+		{
+			MinX = FMath::Min(MinX, Position.X);
+			MaxX = FMath::Max(MaxX, Position.X);
+			MinY = FMath::Min(MinY, Position.Y);
+			MaxY = FMath::Max(MaxY, Position.Y);
+		}
+
+		double GetStrideX() const { return MaxX >= MinX ? MaxX - MinX : 0.0; }
+		double GetStrideY() const { return MaxY >= MinY ? MaxY - MinY : 0.0; }
+	};
+
+	// In-place iterative radix-2 FFT (Re/Im size must be a power of two)
+	void FFTRadix2(TArray<double>& Re, TArray<double>& Im, bool bInverse)
+	{
+		const int32 N = Re.Num();
+
+		// Bit-reversal permutation
+		for (int32 i = 1, j = 0; i < N; ++i)
+		{
+			int32 Bit = N >> 1;
+			for (; j & Bit; Bit >>= 1)
+			{
+				j ^= Bit;
+			}
+			j ^= Bit;
+			if (i < j)
+			{
+				Swap(Re[i], Re[j]);
+				Swap(Im[i], Im[j]);
+			}
+		}
+
+		// Butterflies
+		for (int32 Len = 2; Len <= N; Len <<= 1)
+		{
+			const double Angle = (bInverse ? 2.0 : -2.0) * UE_DOUBLE_PI / Len;
+			const double StepRe = FMath::Cos(Angle);
+			const double StepIm = FMath::Sin(Angle);
+			for (int32 Start = 0; Start < N; Start += Len)
+			{
+				double WRe = 1.0;
+				double WIm = 0.0;
+				for (int32 k = 0; k < Len / 2; ++k)
+				{
+					const int32 A = Start + k;
+					const int32 B = A + Len / 2;
+					const double TRe = Re[B] * WRe - Im[B] * WIm;
+					const double TIm = Re[B] * WIm + Im[B] * WRe;
+					Re[B] = Re[A] - TRe;
+					Im[B] = Im[A] - TIm;
+					Re[A] += TRe;
+					Im[A] += TIm;
+
+					const double NextWRe = WRe * StepRe - WIm * StepIm;
+					WIm = WRe * StepIm + WIm * StepRe;
+					WRe = NextWRe;
+				}
+			}
+		}
+
+		if (bInverse)
+		{
+			for (int32 i = 0; i < N; ++i)
+			{
+				Re[i] /= N;
+				Im[i] /= N;
+			}
+		}
+	}
+
+	// Add the linear (zero-padded) autocorrelation of a mean-removed signal to InOutAutocorrelation
+	// Wiener-Khinchin: ACF = IFFT(|FFT(x)|^2), O(n log n)
+	void AccumulateAutocorrelation(const TArray<double>& Signal, TArray<double>& InOutAutocorrelation)
+	{
+		const int32 N = Signal.Num();
+		const int32 Size = int32(FMath::RoundUpToPowerOfTwo(uint32(2 * N)));
+
+		double Mean = 0.0;
+		for (double Value : Signal)
+		{
+			Mean += Value;
+		}
+		Mean /= N;
+
+		TArray<double> Re;
+		TArray<double> Im;
+		Re.SetNumZeroed(Size);
+		Im.SetNumZeroed(Size);
+		for (int32 i = 0; i < N; ++i)
+		{
+			Re[i] = Signal[i] - Mean;
+		}
+
+		FFTRadix2(Re, Im, false);
+		for (int32 i = 0; i < Size; ++i)
+		{
+			Re[i] = Re[i] * Re[i] + Im[i] * Im[i];
+			Im[i] = 0.0;
+		}
+		FFTRadix2(Re, Im, true);
+
+		InOutAutocorrelation.SetNumZeroed(N);
+		for (int32 Lag = 0; Lag < N; ++Lag)
+		{
+			InOutAutocorrelation[Lag] += Re[Lag];
+		}
+	}
+
+	// Sample rate (Hz) of the trajectory used for cycle detection
+	constexpr double CycleDetectionSampleRate = 15.0;
+
+	// Full cycles a clip must hold before only its first cycle is analyzed
+	constexpr int32 MinDetectedCycles = 2;
+
+	// Dominant locomotion cycle period (seconds) from the autocorrelation of the contact bone trajectories.
+	// Returns 0 when the clip does not hold at least two full cycles.
+	double DetectCyclePeriod(const UAnimSequence* Animation, const TArray<int32>& BoneIndices, int32 NumKeys, double MinCorrelation)
+	{
+		const double PlayLength = Animation->GetPlayLength();
+		const double DeltaTime = PlayLength / double(NumKeys);
+		const int32 KeyStep = FMath::Max(1, FMath::FloorToInt32((NumKeys / PlayLength) / CycleDetectionSampleRate));
+		const double SampleInterval = KeyStep * DeltaTime;
+
+		const int32 NumSamples = FMath::DivideAndRoundUp(NumKeys, KeyStep);
+		if (NumSamples < 8)
+		{
+			return 0.0;
+		}
+
+		// Each bone axis is one channel; per-bone signals keep the stride (not step) period for bipeds
+		TArray<TArray<double>> Channels;
+		Channels.SetNum(BoneIndices.Num() * 3);
+		for (TArray<double>& Channel : Channels)
+		{
+			Channel.SetNumUninitialized(NumSamples);
+		}
+
+		// Key blocks fill disjoint ranges of the channels
+		const FContactBoneSampler Sampler(Animation, BoneIndices);
+		const int32 NumBlocks = GetNumAnalysisBlocks(NumSamples);
+		ParallelFor(NumBlocks, [&](int32 BlockIndex)
+		{
+			FContactBoneSampler BlockSampler = Sampler;
+			TArray<FVector> Positions;
+			const int32 FirstSample = BlockIndex * AnalysisBlockKeys;
+			const int32 EndSample = FMath::Min(FirstSample + AnalysisBlockKeys, NumSamples);
+			for (int32 SampleIndex = FirstSample; SampleIndex < EndSample; ++SampleIndex)
+			{
+				BlockSampler.Sample(SampleIndex * KeyStep * DeltaTime, Positions);
+				for (int32 i = 0; i < Positions.Num(); ++i)
+				{
+					Channels[i * 3 + 0][SampleIndex] = Positions[i].X;
+					Channels[i * 3 + 1][SampleIndex] = Positions[i].Y;
+					Channels[i * 3 + 2][SampleIndex] = Positions[i].Z;
+				}
+			}
+		}, NumBlocks > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+		TArray<double> Autocorrelation;
+		for (const TArray<double>& Channel : Channels)
+		{
+			AccumulateAutocorrelation(Channel, Autocorrelation);
+		}
+		if (Autocorrelation[0] <= UE_DOUBLE_KINDA_SMALL_NUMBER)
+		{
+			return 0.0;
+		}
+
+		// Unbiased, normalized to 1 at lag 0
+		TArray<double> Normalized;
+		Normalized.SetNum(NumSamples);
+		for (int32 Lag = 0; Lag < NumSamples; ++Lag)
+		{
+			Normalized[Lag] = (Autocorrelation[Lag] / (NumSamples - Lag)) / (Autocorrelation[0] / NumSamples);
+		}
+
+		// First local maximum after the first zero crossing, with at least two cycles in the clip
+		const int32 MaxLag = NumSamples / MinDetectedCycles;
+		int32 Lag = 1;
+		while (Lag < MaxLag && Normalized[Lag] > 0.0)
+		{
+			++Lag;
+		}
+
+		int32 PeakLag = INDEX_NONE;
+		for (++Lag; Lag < MaxLag; ++Lag)
+		{
+			if (Normalized[Lag] >= MinCorrelation
+				&& Normalized[Lag] >= Normalized[Lag - 1]
+				&& Normalized[Lag] >= Normalized[Lag + 1])
+			{
+				PeakLag = Lag;
+				break;
+			}
+		}
+		if (PeakLag == INDEX_NONE)
+		{
+			return 0.0;
+		}
+
+		// Parabolic interpolation of the peak between samples
+		const double Left = Normalized[PeakLag - 1];
+		const double Center = Normalized[PeakLag];
+		const double Right = Normalized[PeakLag + 1];
+		const double Denominator = Left - 2.0 * Center + Right;
+		const double Offset = FMath::Abs(Denominator) > UE_DOUBLE_KINDA_SMALL_NUMBER
+			? FMath::Clamp(0.5 * (Left - Right) / Denominator, -0.5, 0.5)
+			: 0.0;
+		double Period = (PeakLag + Offset) * SampleInterval;
+
+		// Loop clips hold a whole number of cycles; snap when close
+		const int32 NumCycles = FMath::RoundToInt32(PlayLength / Period);
+		if (NumCycles >= MinDetectedCycles && FMath::Abs(PlayLength / NumCycles - Period) < 0.05 * Period)
+		{
+			Period = PlayLength / NumCycles;
+		}
+
+		UE_LOG(LogBlendSpaceBuilder, Verbose, TEXT("Cycle: '%s' period %.3fs (%.2f cycles, correlation %.2f)"),
+			*Animation->GetName(), Period, PlayLength / Period, Center);
+		// The interpolated peak can land just past the search range; a snapped period holds exactly NumCycles
+		return (PlayLength / Period >= MinDetectedCycles - UE_KINDA_SMALL_NUMBER) ? Period : 0.0;
+	}
+
+	// Streaming accumulators for one contact bone
+	struct FContactBoneTrack
+	{
+		FContactBoneTrack(FName InBoneName, double GroundHeight, double HeightTolerance, double MaxVerticalSpeed)
+			: BoneName(InBoneName)
+			, Estimator(GroundHeight, HeightTolerance, MaxVerticalSpeed)
+			, CoarseEstimator(GroundHeight, HeightTolerance, MaxVerticalSpeed)
+		{
+		}
+
+		FName BoneName;
+		FContactPhaseVelocityEstimator Estimator;
+		FContactPhaseVelocityEstimator CoarseEstimator;
+		FFootExtents Extents;
+		FFootExtents CoarseExtents;
+	};
+
+	// Contact bone tracks accumulated over the analysis window
+	struct FContactBoneSamples
+	{
+		TArray<FContactBoneTrack> Tracks;
+		int32 NumKeysEvaluated = 0;
+
+		/** Duration of the analyzed window: one detected cycle, or the whole clip */
+		double WindowLength = 0.0;
+	};
+
+	// Single streaming pass over the keys that samples every contact bone per key.
+	// Bone positions are evaluated in parallel key blocks and accumulated in key order.
+	// When the clip repeats its cycle, only the first detected cycle is analyzed.
+	bool SampleContactBoneTracks(
+		const UAnimSequence* Animation,
+		const TArray<FName>& ContactBoneNames,
+		const FKeySampling& Sampling,
+		const FBlendSpaceAnalysisSettings& Settings,
+		FContactBoneSamples& OutSamples)
+	{
+		TArray<int32> BoneIndices;
+		TArray<FName> BoneNames;
+		int32 NumKeys = 0;
+		if (!ResolveContactBones(Animation, ContactBoneNames, BoneIndices, BoneNames, NumKeys))
+		{
+			return false;
+		}
+
+		const FReferenceSkeleton& RefSkeleton = Animation->GetSkeleton()->GetReferenceSkeleton();
+		const double PlayLength = Animation->GetPlayLength();
+		const double DeltaTime = PlayLength / double(NumKeys);
+
+		// Reference pose bone height is the ground height of a standing character in component space
+		for (int32 i = 0; i < BoneIndices.Num(); ++i)
+		{
+			const double GroundHeight = GetRefPoseComponentSpaceTransform(RefSkeleton, BoneIndices[i]).GetTranslation().Z;
+			OutSamples.Tracks.Emplace(BoneNames[i], GroundHeight, Settings.FootContactHeightTolerance, Settings.FootContactMaxVerticalSpeed);
+		}
+
+		// Restrict the window to one cycle for clips that hold several
+		int32 WindowKeys = NumKeys;
+		OutSamples.WindowLength = PlayLength;
+		const double CyclePeriod = Settings.bDetectLocomotionCycles
+			? DetectCyclePeriod(Animation, BoneIndices, NumKeys, Settings.CycleDetectionMinCorrelation)
+			: 0.0;
+		if (CyclePeriod > 0.0)
+		{
+			WindowKeys = FMath::Min(NumKeys, FMath::RoundToInt32(CyclePeriod / DeltaTime) + 1);
+			OutSamples.WindowLength = CyclePeriod;
+		}
+
+		const int32 NumSamples = FMath::DivideAndRoundUp(WindowKeys, Sampling.KeyStep);
+		const int32 NumBlocks = GetNumAnalysisBlocks(NumSamples);
+		const int32 NumBones = BoneIndices.Num();
+
+		const FContactBoneSampler Sampler(Animation, BoneIndices);
+		TArray<FVector> PassPositions;
+		for (int32 PassSample = 0; PassSample < NumSamples; PassSample += AnalysisPassKeys)
+		{
+			// Blocks evaluate disjoint ranges of the pass positions (sample-major)
+			const int32 PassEndSample = FMath::Min(PassSample + AnalysisPassKeys, NumSamples);
+			const int32 NumPassBlocks = GetNumAnalysisBlocks(PassEndSample - PassSample);
+			PassPositions.SetNumUninitialized((PassEndSample - PassSample) * NumBones);
+			ParallelFor(NumPassBlocks, [&](int32 BlockIndex)
+			{
+				FContactBoneSampler BlockSampler = Sampler;
+				TArray<FVector> Positions;
+				const int32 FirstSample = PassSample + BlockIndex * AnalysisBlockKeys;
+				const int32 EndSample = FMath::Min(FirstSample + AnalysisBlockKeys, PassEndSample);
+				for (int32 SampleIndex = FirstSample; SampleIndex < EndSample; ++SampleIndex)
+				{
+					BlockSampler.Sample(SampleIndex * Sampling.KeyStep * DeltaTime, Positions);
+					FMemory::Memcpy(&PassPositions[(SampleIndex - PassSample) * NumBones], Positions.GetData(), NumBones * sizeof(FVector));
+				}
+			}, NumPassBlocks > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+			// Accumulated serially in key order, so the sums match a single-threaded pass bit for bit
+			for (int32 SampleIndex = PassSample; SampleIndex < PassEndSample; ++SampleIndex)
+			{
+				const int32 Key = SampleIndex * Sampling.KeyStep;
+				const double Time = Key * DeltaTime;
+				const bool bCoarseKey = Sampling.bEstimateError && Key % (2 * Sampling.KeyStep) == 0;
+				const FVector* Positions = &PassPositions[(SampleIndex - PassSample) * NumBones];
+
+				for (int32 i = 0; i < OutSamples.Tracks.Num(); ++i)
+				{
+					FContactBoneTrack& Track = OutSamples.Tracks[i];
+					Track.Estimator.AddKey(Positions[i], Time);
+					Track.Extents.Add(Positions[i]);
+					if (bCoarseKey)
+					{
+						Track.CoarseEstimator.AddKey(Positions[i], Time);
+						Track.CoarseExtents.Add(Positions[i]);
+					}
+				}
+			}
+		}
+		OutSamples.NumKeysEvaluated = NumSamples;
+
+		UE_LOG(LogBlendSpaceBuilder, Verbose, TEXT("Locomotion: '%s' sampled %d contact bones (%d unique bones) over %d keys in %d blocks, window %.2fs"),
+			*Animation->GetName(), OutSamples.Tracks.Num(), Sampler.GetNumRequiredBones(), OutSamples.NumKeysEvaluated, NumBlocks, OutSamples.WindowLength);
+		return true;
+	}
+
+	// Character velocity from planted contact bone displacement, averaged over bones
+	// Falls back to the average over every sampled key for bones with no contact phase
+	FVector GetContactPhaseVelocity(const UAnimSequence* Animation, const TArray<FContactBoneTrack>& Tracks, bool bCoarse)
+	{
+		FVector Sum = FVector::ZeroVector;
+		int32 Count = 0;
+		for (const FContactBoneTrack& Track : Tracks)
+		{
+			const FContactPhaseVelocityEstimator& Estimator = bCoarse ? Track.CoarseEstimator : Track.Estimator;
+
+			// Planted bone moves opposite to the character
+			const FVector Velocity = -Estimator.GetVelocity() * Animation->RateScale;
+			if (!Velocity.IsNearlyZero())
+			{
+				Sum += FVector(Velocity.X, Velocity.Y, 0.f);
+				Count++;
+			}
+		}
+		return (Count > 0) ? Sum / Count : FVector::ZeroVector;
+	}
+
+	// Calculate locomotion velocity from planted contact bones (Simple)
+	FVelocityEstimate CalculateLocomotionVelocitySimple(
+		const UAnimSequence* Animation,
+		const TArray<FName>& ContactBoneNames,
+		const FKeySampling& Sampling,
+		const FBlendSpaceAnalysisSettings& Settings)
+	{
+		FVelocityEstimate Result;
+		FContactBoneSamples Samples;
+		if (!SampleContactBoneTracks(Animation, ContactBoneNames, Sampling, Settings, Samples))
+		{
+			return Result;
+		}
+		const TArray<FContactBoneTrack>& Tracks = Samples.Tracks;
+		Result.NumKeysEvaluated = Samples.NumKeysEvaluated;
+
+		for (const FContactBoneTrack& Track : Tracks)
+		{
+			if (!Track.Estimator.HasContact())
+			{
+				UE_LOG(LogBlendSpaceBuilder, Warning,
+					TEXT("LocomotionSimple: '%s' bone '%s' has no ground contact phase, using all keys"),
+					*Animation->GetName(), *Track.BoneName.ToString());
+			}
+		}
+
+		Result.Velocity = GetContactPhaseVelocity(Animation, Tracks, false);
+		Result.CoarseVelocity = GetContactPhaseVelocity(Animation, Tracks, true);
+
+		UE_LOG(LogBlendSpaceBuilder, Verbose, TEXT("LocomotionSimple: '%s' -> Velocity(%.1f, %.1f)"),
+			*Animation->GetName(), Result.Velocity.X, Result.Velocity.Y);
+		return Result;
+	}
+
+	// Calculate locomotion velocity using stride length (max - min position), in the same pass as Simple
+	// Combines Simple (direction) + Stride (magnitude) for accurate results
+	FVelocityEstimate CalculateLocomotionVelocityStride(
+		const UAnimSequence* Animation,
+		const TArray<FName>& ContactBoneNames,
+		const FKeySampling& Sampling,
+		const FBlendSpaceAnalysisSettings& Settings)
+	{
+		FVelocityEstimate Result;
+		FContactBoneSamples Samples;
+		if (!SampleContactBoneTracks(Animation, ContactBoneNames, Sampling, Settings, Samples))
+		{
+			return Result;
+		}
+		const TArray<FContactBoneTrack>& Tracks = Samples.Tracks;
+		Result.NumKeysEvaluated = Samples.NumKeysEvaluated;
+
+		// Velocity = Stride / cycle length (window is one detected cycle, or the whole clip)
+		// Each bone covers one stride per cycle; a biped cycle is two steps, so the mean extent is doubled
+		// (equal to the sum of both feet for bipeds)
+		const double Scale = 2.0 * Animation->RateScale / (Samples.WindowLength * Tracks.Num());
+		FVector StrideSum = FVector::ZeroVector;
+		FVector CoarseStrideSum = FVector::ZeroVector;
+		for (const FContactBoneTrack& Track : Tracks)
+		{
+			StrideSum += FVector(Track.Extents.GetStrideX(), Track.Extents.GetStrideY(), 0.0);
+			CoarseStrideSum += FVector(Track.CoarseExtents.GetStrideX(), Track.CoarseExtents.GetStrideY(), 0.0);
+		}
+
+		// Combine: direction from Simple, magnitude from Stride (X/Y only)
+		auto Combine = [](const FVector& SimpleVelocity, const FVector& StrideVelocity)
+		{
+			const FVector Velocity = SimpleVelocity.GetSafeNormal() * StrideVelocity.Size2D();
+			return FVector(Velocity.X, Velocity.Y, 0.f);
+		};
+
+		Result.Velocity = Combine(GetContactPhaseVelocity(Animation, Tracks, false), StrideSum * Scale);
+		Result.CoarseVelocity = Combine(GetContactPhaseVelocity(Animation, Tracks, true), CoarseStrideSum * Scale);
+
+		UE_LOG(LogBlendSpaceBuilder, Verbose, TEXT("LocomotionStride: '%s' combined Simple dir * Stride mag = (%.1f, %.1f)"),
+			*Animation->GetName(), Result.Velocity.X, Result.Velocity.Y);
+		return Result;
+	}
+
+	// Find the first authored float curve matching any of the given names (in priority order)
+	const FFloatCurve* FindAuthoredFloatCurve(const UAnimSequence* Animation, const TArray<FName>& CurveNames)
+	{
+		const IAnimationDataModel* DataModel = Animation->GetDataModel();
+		if (!DataModel)
+		{
+			return nullptr;
+		}
+
+		const TArray<FFloatCurve>& FloatCurves = DataModel->GetFloatCurves();
+		for (FName CurveName : CurveNames)
+		{
+			for (const FFloatCurve& Curve : FloatCurves)
+			{
+				if (Curve.GetName() == CurveName && Curve.FloatCurve.GetNumKeys() > 0)
+				{
+					return &Curve;
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	// Time-weighted mean speed of a speed curve (trapezoid rule over keys)
+	double GetSpeedFromSpeedCurve(const FRichCurve& Curve)
+	{
+		const TArray<FRichCurveKey>& Keys = Curve.GetConstRefOfKeys();
+		const double Span = Keys.Last().Time - Keys[0].Time;
+		if (Keys.Num() == 1 || Span <= KINDA_SMALL_NUMBER)
+		{
+			return FMath::Abs(Keys[0].Value);
+		}
+
+		double Area = 0.0;
+		for (int32 i = 1; i < Keys.Num(); ++i)
+		{
+			Area += 0.5 * (FMath::Abs(Keys[i - 1].Value) + FMath::Abs(Keys[i].Value)) * (Keys[i].Time - Keys[i - 1].Time);
+		}
+		return Area / Span;
+	}
+
+	// Mean speed from a distance curve (travelled distance / time)
+	// Deltas against the dominant direction are skipped so a loop reset does not count as travel
+	double GetSpeedFromDistanceCurve(const FRichCurve& Curve)
+	{
+		const TArray<FRichCurveKey>& Keys = Curve.GetConstRefOfKeys();
+		const double Span = Keys.Last().Time - Keys[0].Time;
+		if (Keys.Num() < 2 || Span <= KINDA_SMALL_NUMBER)
+		{
+			return 0.0;
+		}
+
+		double Forward = 0.0;
+		double Backward = 0.0;
+		for (int32 i = 1; i < Keys.Num(); ++i)
+		{
+			const double Delta = Keys[i].Value - Keys[i - 1].Value;
+			(Delta >= 0.0 ? Forward : Backward) += FMath::Abs(Delta);
+		}
+		return FMath::Max(Forward, Backward) / Span;
+	}
+
+	// Fast path: velocity magnitude from authored speed/distance curves, without evaluating bones
+	// Curves carry no direction, so the speed is stored on the forward axis (role direction is applied later)
+	bool TryCalculateVelocityFromCurves(const UAnimSequence* Animation, const FBlendSpaceAnalysisSettings& Settings, FBlendSpaceAnalysisResult& OutResult)
+	{
+		double Speed = 0.0;
+		EBlendSpaceVelocitySource Source = EBlendSpaceVelocitySource::None;
+		const FFloatCurve* Curve = FindAuthoredFloatCurve(Animation, Settings.SpeedCurveNames);
+		if (Curve)
+		{
+			Speed = GetSpeedFromSpeedCurve(Curve->FloatCurve);
+			Source = EBlendSpaceVelocitySource::SpeedCurve;
+		}
+		else if ((Curve = FindAuthoredFloatCurve(Animation, Settings.DistanceCurveNames)) != nullptr)
+		{
+			Speed = GetSpeedFromDistanceCurve(Curve->FloatCurve);
+			Source = EBlendSpaceVelocitySource::DistanceCurve;
+		}
+		else
+		{
+			return false;
+		}
+
+		Speed *= Animation->RateScale;
+
+		// A flat curve is more likely a placeholder than a stationary cycle; let the bones decide
+		if (Speed < Settings.MinVelocityThreshold)
+		{
+			UE_LOG(LogBlendSpaceBuilder, Log, TEXT("Curve: '%s' curve '%s' speed (%.2f) below threshold, falling back to foot bones"),
+				*Animation->GetName(), *Curve->GetName().ToString(), Speed);
+			return false;
+		}
+
+		OutResult.Velocity = FVector(0.f, Speed, 0.f);
+		OutResult.Source = Source;
+		OutResult.SourceCurveName = Curve->GetName();
+		OutResult.Quality = EBlendSpaceAnalysisQuality::Exact;
+		OutResult.ErrorEstimate = 0.f;
+		OutResult.NumKeysEvaluated = 0;
+
+		UE_LOG(LogBlendSpaceBuilder, Verbose, TEXT("Curve: '%s' curve '%s' -> Speed %.1f"),
+			*Animation->GetName(), *Curve->GetName().ToString(), Speed);
+		return true;
+	}
+
+	// Foot contact event from a sync marker or notify
+	struct FFootContactEvent
+	{
+		double Time = 0.0;
+		bool bLeft = true;
+	};
+
+	// Collect foot contact times from sync markers, or from notifies when the clip has no foot markers
+	TArray<FFootContactEvent> CollectFootContactEvents(const UAnimSequence* Animation, const FBlendSpaceAnalysisSettings& Settings)
+	{
+		const double PlayLength = Animation->GetPlayLength();
+
+		TArray<FFootContactEvent> Events;
+		auto AddEvent = [&](FName Name, double Time)
+		{
+			if (Time < 0.0 || Time > PlayLength)
+			{
+				return;
+			}
+			if (Settings.LeftFootMarkerNames.Contains(Name))
+			{
+				Events.Add({Time, true});
+			}
+			else if (Settings.RightFootMarkerNames.Contains(Name))
+			{
+				Events.Add({Time, false});
+			}
+		};
+
+		for (const FAnimSyncMarker& Marker : Animation->AuthoredSyncMarkers)
+		{
+			AddEvent(Marker.MarkerName, Marker.Time);
+		}
+
+		// Clips usually carry either markers or footstep notifies; using both would count steps twice
+		if (Events.Num() == 0)
+		{
+			for (const FAnimNotifyEvent& Notify : Animation->Notifies)
+			{
+				AddEvent(Notify.NotifyName, Notify.GetTriggerTime());
+			}
+		}
+
+		Events.Sort([](const FFootContactEvent& A, const FFootContactEvent& B) { return A.Time < B.Time; });
+
+		// A looping clip's end is its start: a marker authored at both 0 and PlayLength is one contact
+		if (Animation->bLoop)
+		{
+			const double WrapTolerance = 0.5 * Animation->GetSamplingFrameRate().AsInterval();
+			for (int32 Index = Events.Num() - 1; Index >= 0 && Events[Index].Time >= PlayLength - WrapTolerance; --Index)
+			{
+				const bool bLeft = Events[Index].bLeft;
+				if (Events.ContainsByPredicate([bLeft, WrapTolerance](const FFootContactEvent& Event) { return Event.bLeft == bLeft && Event.Time <= WrapTolerance; }))
+				{
+					Events.RemoveAt(Index);
+				}
+			}
+		}
+		return Events;
+	}
+
+	// Fast path for Stride: sample both feet only at authored foot contact times.
+	// At each contact the landing foot is one step ahead of the other foot in the travel direction
+	// (after removing the reference pose stance offset), so the summed step vectors over the clip
+	// are the travelled distance.
+	bool TryCalculateVelocityFromFootMarkers(
+		const UAnimSequence* Animation,
+		FName LeftFootBone,
+		FName RightFootBone,
+		const FBlendSpaceAnalysisSettings& Settings,
+		FBlendSpaceAnalysisResult& OutResult)
+	{
+		const double PlayLength = Animation->GetPlayLength();
+		const USkeleton* Skeleton = Animation->GetSkeleton();
+		if (!Skeleton || PlayLength <= KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+		const int32 LeftIndex = RefSkeleton.FindBoneIndex(LeftFootBone);
+		const int32 RightIndex = RefSkeleton.FindBoneIndex(RightFootBone);
+		if (LeftIndex == INDEX_NONE || RightIndex == INDEX_NONE)
+		{
+			return false;
+		}
+
+		const TArray<FFootContactEvent> Events = CollectFootContactEvents(Animation, Settings);
+		const bool bHasLeft = Events.ContainsByPredicate([](const FFootContactEvent& Event) { return Event.bLeft; });
+		const bool bHasRight = Events.ContainsByPredicate([](const FFootContactEvent& Event) { return !Event.bLeft; });
+		if (!bHasLeft || !bHasRight)
+		{
+			return false;
+		}
+
+		// Stance offset (left - right) of a standing character
+		const FVector RefStanceOffset = GetRefPoseComponentSpaceTransform(RefSkeleton, LeftIndex).GetTranslation()
+			- GetRefPoseComponentSpaceTransform(RefSkeleton, RightIndex).GetTranslation();
+
+		FContactBoneSampler Sampler(Animation, {LeftIndex, RightIndex});
+		TArray<FVector> Positions;
+
+		// A contact between two keys interpolates both of them
+		const FFrameRate FrameRate = Animation->GetSamplingFrameRate();
+		TSet<int32> EvaluatedKeys;
+
+		FVector TravelledDistance = FVector::ZeroVector;
+		for (const FFootContactEvent& Event : Events)
+		{
+			const FFrameTime FrameTime = FrameRate.AsFrameTime(Event.Time);
+			EvaluatedKeys.Add(FrameTime.FrameNumber.Value);
+			if (FrameTime.GetSubFrame() > 0.f)
+			{
+				EvaluatedKeys.Add(FrameTime.FrameNumber.Value + 1);
+			}
+
+			Sampler.Sample(Event.Time, Positions);
+			const FVector& LeftPos = Positions[0];
+			const FVector& RightPos = Positions[1];
+			const FVector Step = Event.bLeft
+				? (LeftPos - RightPos) - RefStanceOffset
+				: (RightPos - LeftPos) + RefStanceOffset;
+			TravelledDistance += Step;
+		}
+
+		const FVector Velocity = TravelledDistance * (Animation->RateScale / PlayLength);
+		if (Velocity.Size2D() < Settings.MinVelocityThreshold)
+		{
+			UE_LOG(LogBlendSpaceBuilder, Log, TEXT("LocomotionStride: '%s' foot markers give no travel, falling back to foot extents"),
+				*Animation->GetName());
+			return false;
+		}
+
+		OutResult.Velocity = FVector(Velocity.X, Velocity.Y, 0.f);
+		OutResult.Source = EBlendSpaceVelocitySource::FootMarkers;
+		OutResult.Quality = EBlendSpaceAnalysisQuality::Exact;
+		OutResult.ErrorEstimate = 0.f;
+		OutResult.NumKeysEvaluated = EvaluatedKeys.Num();
+
+		UE_LOG(LogBlendSpaceBuilder, Verbose, TEXT("LocomotionStride: '%s' %d foot contacts -> Velocity(%.1f, %.1f)"),
+			*Animation->GetName(), Events.Num(), OutResult.Velocity.X, OutResult.Velocity.Y);
+		return true;
+	}
+
+	// Left/right partner role (roles without a lateral component return themselves)
+	ELocomotionRole GetMirroredRole(ELocomotionRole Role)
+	{
+		switch (Role)
+		{
+		case ELocomotionRole::WalkLeft:				return ELocomotionRole::WalkRight;
+		case ELocomotionRole::WalkRight:			return ELocomotionRole::WalkLeft;
+		case ELocomotionRole::WalkForwardLeft:		return ELocomotionRole::WalkForwardRight;
+		case ELocomotionRole::WalkForwardRight:		return ELocomotionRole::WalkForwardLeft;
+		case ELocomotionRole::WalkBackwardLeft:		return ELocomotionRole::WalkBackwardRight;
+		case ELocomotionRole::WalkBackwardRight:	return ELocomotionRole::WalkBackwardLeft;
+		case ELocomotionRole::RunLeft:				return ELocomotionRole::RunRight;
+		case ELocomotionRole::RunRight:				return ELocomotionRole::RunLeft;
+		case ELocomotionRole::RunForwardLeft:		return ELocomotionRole::RunForwardRight;
+		case ELocomotionRole::RunForwardRight:		return ELocomotionRole::RunForwardLeft;
+		case ELocomotionRole::RunBackwardLeft:		return ELocomotionRole::RunBackwardRight;
+		case ELocomotionRole::RunBackwardRight:		return ELocomotionRole::RunBackwardLeft;
+		default:									return Role;
+		}
+	}
+
+	// Mirror axis and bone pairing used to compare mirrored clips
+	struct FMirrorSpec
+	{
+		EAxis::Type Axis = EAxis::X;
+		TMap<FName, FName> BonePairs;
+
+		FName GetMirroredBone(FName Bone) const
+		{
+			const FName* Mirrored = BonePairs.Find(Bone);
+			return Mirrored ? *Mirrored : Bone;
+		}
+
+		FVector Reflect(FVector Vector) const
+		{
+			switch (Axis)
+			{
+			case EAxis::X: Vector.X = -Vector.X; break;
+			case EAxis::Y: Vector.Y = -Vector.Y; break;
+			case EAxis::Z: Vector.Z = -Vector.Z; break;
+			default: break;
+			}
+			return Vector;
+		}
+	};
+
+	// Mirror spec from the mirror table captured in the settings, or the left/right foot swap across X
+	FMirrorSpec GetMirrorSpec(const FBlendSpaceAnalysisOptions& Options)
+	{
+		FMirrorSpec Spec;
+		if (Options.LeftFootBone != NAME_None && Options.RightFootBone != NAME_None)
+		{
+			Spec.BonePairs.Add(Options.LeftFootBone, Options.RightFootBone);
+			Spec.BonePairs.Add(Options.RightFootBone, Options.LeftFootBone);
+		}
+
+		const FBlendSpaceAnalysisSettings& Settings = Options.GetSettings();
+		Spec.Axis = Settings.MirrorAxis;
+		Spec.BonePairs.Append(Settings.MirrorBonePairs);
+		return Spec;
+	}
+
+	// Number of normalized times compared by the mirror signature
+	constexpr int32 MirrorSignatureSamples = 16;
+
+	// Cheap trajectory signature test: Candidate is Source mirrored when every contact bone of Candidate
+	// matches the reflected mirrored bone of Source at the same normalized times
+	bool IsMirroredPair(
+		const UAnimSequence* Source,
+		const UAnimSequence* Candidate,
+		const TArray<FName>& ContactBoneNames,
+		const FMirrorSpec& Spec,
+		double Tolerance)
+	{
+		if (!Source || !Candidate || Source->GetSkeleton() != Candidate->GetSkeleton() || !Source->GetSkeleton())
+		{
+			return false;
+		}
+
+		const double SourceLength = Source->GetPlayLength();
+		const double CandidateLength = Candidate->GetPlayLength();
+		if (SourceLength <= KINDA_SMALL_NUMBER || !FMath::IsNearlyEqual(SourceLength, CandidateLength, 0.01 * SourceLength)
+			|| !FMath::IsNearlyEqual(Source->RateScale, Candidate->RateScale))
+		{
+			return false;
+		}
+
+		const FReferenceSkeleton& RefSkeleton = Source->GetSkeleton()->GetReferenceSkeleton();
+		TArray<int32> CandidateBones;
+		TArray<int32> SourceBones;
+		for (FName Bone : ContactBoneNames)
+		{
+			const int32 BoneIndex = RefSkeleton.FindBoneIndex(Bone);
+			const int32 MirroredIndex = RefSkeleton.FindBoneIndex(Spec.GetMirroredBone(Bone));
+			if (BoneIndex == INDEX_NONE || MirroredIndex == INDEX_NONE)
+			{
+				return false;
+			}
+			CandidateBones.Add(BoneIndex);
+			SourceBones.Add(MirroredIndex);
+		}
+		if (CandidateBones.Num() == 0)
+		{
+			return false;
+		}
+
+		FContactBoneSampler SourceSampler(Source, SourceBones);
+		FContactBoneSampler CandidateSampler(Candidate, CandidateBones);
+		TArray<FVector> SourcePositions;
+		TArray<FVector> CandidatePositions;
+		const double ToleranceSquared = Tolerance * Tolerance;
+		for (int32 i = 0; i < MirrorSignatureSamples; ++i)
+		{
+			const double Alpha = (i + 0.5) / MirrorSignatureSamples;
+			SourceSampler.Sample(Alpha * SourceLength, SourcePositions);
+			CandidateSampler.Sample(Alpha * CandidateLength, CandidatePositions);
+			for (int32 Bone = 0; Bone < CandidatePositions.Num(); ++Bone)
+			{
+				if (FVector::DistSquared(Spec.Reflect(SourcePositions[Bone]), CandidatePositions[Bone]) > ToleranceSquared)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// Partner animations that are mirrors of an animation analyzed in the same batch (partner -> source)
+	TMap<UAnimSequence*, UAnimSequence*> FindMirroredPairs(
+		const TMap<ELocomotionRole, UAnimSequence*>& Animations,
+		const FBlendSpaceAnalysisOptions& Options)
 	{
-		if (!Animation || FootBoneName == NAME_None)
+		TMap<UAnimSequence*, UAnimSequence*> Partners;
+		const FBlendSpaceAnalysisSettings& Settings = Options.GetSettings();
+
+		// Root motion analysis is a single extraction per clip, cheaper than the signature test
+		if (!Options.bReuseMirroredAnalysis || !Settings.bReuseMirroredAnalysis
+			|| Options.AnalysisType == EBlendSpaceAnalysisType::RootMotion)
 		{
-			UE_LOG(LogBlendSpaceBuilder, Warning, TEXT("Locomotion: Invalid input (Anim=%s, Bone=%s)"),
-				Animation ? *Animation->GetName() : TEXT("null"), *FootBoneName.ToString());
-			return false;
+			return Partners;
 		}
 
-		const int32 NumKeys = Animation->GetNumberOfSampledKeys();
-		if (NumKeys <= 1)
+		const FMirrorSpec Spec = GetMirrorSpec(Options);
+		const TArray<FName> ContactBoneNames = Options.GetContactBones();
+		for (const auto& Pair : Animations)
 		{
-			UE_LOG(LogBlendSpaceBuilder, Warning, TEXT("Locomotion: '%s' has insufficient keys (%d)"),
-				*Animation->GetName(), NumKeys);
-			return false;
+			// Visit each pair once, from its Left role
+			const ELocomotionRole PartnerRole = GetMirroredRole(Pair.Key);
+			if (PartnerRole == Pair.Key || GetRoleDirectionSign(Pair.Key).X >= 0.f)
+			{
+				continue;
+			}
+
+			UAnimSequence* const* Partner = Animations.Find(PartnerRole);
+			if (Pair.Value && Partner && *Partner && *Partner != Pair.Value
+				&& IsMirroredPair(Pair.Value, *Partner, ContactBoneNames, Spec, Settings.MirrorSignatureTolerance))
+			{
+				UE_LOG(LogBlendSpaceBuilder, Verbose, TEXT("Mirror: '%s' is a mirror of '%s', reusing its analysis"),
+					*(*Partner)->GetName(), *Pair.Value->GetName());
+				Partners.Add(*Partner, Pair.Value);
+			}
 		}
+		return Partners;
+	}
 
-		USkeleton* Skeleton = Animation->GetSkeleton();
-		if (!Skeleton)
+	// Analyze a single animation with the given options
+	FBlendSpaceAnalysisResult AnalyzeSingleAnimation(UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options)
+	{
+		FBlendSpaceAnalysisResult Result;
+		Result.Quality = Options.Quality;
+		Result.ResolvedAnalysisType = Options.AnalysisType;
+		if (!Animation)
 		{
-			UE_LOG(LogBlendSpaceBuilder, Warning, TEXT("Locomotion: '%s' has no skeleton"),
-				*Animation->GetName());
-			return false;
+			return Result;
 		}
+		const FBlendSpaceAnalysisSettings& Settings = Options.GetSettings();
 
-		int32 BoneIndex = Skeleton->GetReferenceSkeleton().FindBoneIndex(FootBoneName);
-		if (BoneIndex == INDEX_NONE)
+		// Auto: a single root motion extraction decides whether foot analysis is needed at all
+		EBlendSpaceAnalysisType AnalysisType = Options.AnalysisType;
+		if (AnalysisType == EBlendSpaceAnalysisType::Auto)
 		{
-			UE_LOG(LogBlendSpaceBuilder, Warning, TEXT("Locomotion: '%s' foot bone '%s' not found in skeleton"),
-				*Animation->GetName(), *FootBoneName.ToString());
-			return false;
-		}
+			const FVector ProbeVelocity = ProbeRootMotionVelocity(Animation);
+			const bool bHasRootMotion = ProbeVelocity.Size2D() >= Settings.MinVelocityThreshold;
+			AnalysisType = bHasRootMotion ? EBlendSpaceAnalysisType::RootMotion : Options.AutoFootAnalysisType;
+			Result.ResolvedAnalysisType = AnalysisType;
 
-		const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
-		OutDeltaTime = Animation->GetPlayLength() / double(NumKeys);
+			UE_LOG(LogBlendSpaceBuilder, Verbose, TEXT("Auto: '%s' root speed %.1f -> %s"),
+				*Animation->GetName(), ProbeVelocity.Size2D(), bHasRootMotion ? TEXT("RootMotion") : TEXT("foot analysis"));
+
+			if (bHasRootMotion)
+			{
+				Result.Quality = EBlendSpaceAnalysisQuality::Exact;
+				Result.Velocity = FVector(ProbeVelocity.X, ProbeVelocity.Y, 0.f);
+				Result.Source = EBlendSpaceVelocitySource::RootMotion;
+				return Result;
+			}
+		}
 
-		OutPositions.SetNum(NumKeys);
-		for (int32 Key = 0; Key < NumKeys; ++Key)
+		// Root motion is a single exact extraction regardless of quality
+		if (AnalysisType == EBlendSpaceAnalysisType::RootMotion)
 		{
-			FTransform ComponentSpaceTM = GetComponentSpaceTransform(
-				Animation, RefSkeleton, BoneIndex, Key * OutDeltaTime);
-			OutPositions[Key] = ComponentSpaceTM.GetTranslation();
+			Result.Quality = EBlendSpaceAnalysisQuality::Exact;
+			Result.Velocity = CalculateRootMotionVelocity(Animation, Settings);
+			Result.Source = Result.Velocity.IsNearlyZero() ? EBlendSpaceVelocitySource::None : EBlendSpaceVelocitySource::RootMotion;
+			return Result;
 		}
 
-		return true;
-	}
+		// Authored curves are exact and need no bone evaluation
+		if (Options.bUseAuthoredCurves && TryCalculateVelocityFromCurves(Animation, Settings, Result))
+		{
+			return Result;
+		}
 
-	// Calculate locomotion velocity using simple average (no weighting)
-	FVector CalculateLocomotionVelocityFromFootSimple(const UAnimSequence* Animation, FName FootBoneName)
-	{
-		TArray<FVector> Positions;
-		double DeltaTime;
-		if (!CollectFootPositions(Animation, FootBoneName, Positions, DeltaTime))
+		// Authored foot contacts give exact stride boundaries for a handful of evaluations (bipeds only)
+		if (AnalysisType == EBlendSpaceAnalysisType::LocomotionStride
+			&& Options.ContactBones.Num() == 0
+			&& TryCalculateVelocityFromFootMarkers(Animation, Options.LeftFootBone, Options.RightFootBone, Settings, Result))
 		{
-			return FVector::ZeroVector;
+			return Result;
 		}
 
-		const int32 NumKeys = Positions.Num();
+		const FKeySampling Sampling = GetKeySampling(Animation, Options.Quality);
 
-		// Calculate velocities using forward difference
-		TArray<FVector> Velocities;
-		Velocities.SetNum(NumKeys);
-		for (int32 Key = 0; Key < NumKeys - 1; ++Key)
+		FVelocityEstimate Estimate;
+		switch (AnalysisType)
 		{
-			Velocities[Key] = (Positions[Key + 1] - Positions[Key]) / DeltaTime;
+		case EBlendSpaceAnalysisType::RootMotion:
+		case EBlendSpaceAnalysisType::Auto:
+			break;
+		case EBlendSpaceAnalysisType::LocomotionSimple:
+			Estimate = CalculateLocomotionVelocitySimple(Animation, Options.GetContactBones(), Sampling, Settings);
+			break;
+		case EBlendSpaceAnalysisType::LocomotionStride:
+			Estimate = CalculateLocomotionVelocityStride(Animation, Options.GetContactBones(), Sampling, Settings);
+			break;
 		}
-		Velocities[NumKeys - 1] = Velocities[NumKeys - 2];
 
-		// Simple average of all velocities
-		FVector AvgVelocity = FVector::ZeroVector;
-		for (const FVector& Vel : Velocities)
+		Result.Velocity = Estimate.Velocity;
+		Result.ErrorEstimate = Estimate.GetErrorEstimate(Sampling);
+		Result.NumKeysEvaluated = Estimate.NumKeysEvaluated;
+		Result.Source = Result.Velocity.IsNearlyZero() ? EBlendSpaceVelocitySource::None : EBlendSpaceVelocitySource::FootBones;
+		if (!Sampling.bEstimateError)
 		{
-			AvgVelocity += Vel;
+			Result.Quality = EBlendSpaceAnalysisQuality::Exact;
 		}
-		AvgVelocity /= NumKeys;
-
-		FVector CharacterVelocity = -AvgVelocity * Animation->RateScale;
-		UE_LOG(LogBlendSpaceBuilder, Verbose, TEXT("LocomotionSimple: '%s' foot '%s' -> Velocity(%.1f, %.1f)"),
-			*Animation->GetName(), *FootBoneName.ToString(), CharacterVelocity.X, CharacterVelocity.Y);
-		return FVector(CharacterVelocity.X, CharacterVelocity.Y, 0.f);
+		return Result;
 	}
 
-	// Calculate locomotion velocity using stride length (max - min position)
-	FVector CalculateLocomotionVelocityFromFootStride(const UAnimSequence* Animation, FName FootBoneName)
+	// Options with a settings snapshot, captured now when the caller did not provide one
+	FBlendSpaceAnalysisOptions WithSettingsSnapshot(const FBlendSpaceAnalysisOptions& Options)
 	{
-		TArray<FVector> Positions;
-		double DeltaTime;
-		if (!CollectFootPositions(Animation, FootBoneName, Positions, DeltaTime))
+		FBlendSpaceAnalysisOptions Resolved = Options;
+		if (!Resolved.SettingsSnapshot.IsValid())
 		{
-			return FVector::ZeroVector;
+			Resolved.SettingsSnapshot = FBlendSpaceAnalysisSettings::Capture();
 		}
+		return Resolved;
+	}
 
-		const int32 NumKeys = Positions.Num();
-		double PlayLength = Animation->GetPlayLength();
-		if (PlayLength <= KINDA_SMALL_NUMBER)
+	// Stride compensation and role direction, applied to the cached (raw) analysis of a sample
+	FBlendSpaceAnalysisResult FinalizeAnalysis(ELocomotionRole Role, FBlendSpaceAnalysisResult Analysis, const FBlendSpaceAnalysisOptions& Options)
+	{
+		if (Analysis.ResolvedAnalysisType == EBlendSpaceAnalysisType::LocomotionStride
+			&& Analysis.Source == EBlendSpaceVelocitySource::FootBones)
 		{
-			return FVector::ZeroVector;
+			// Apply multiplier for stride (authored curves need no compensation)
+			Analysis.Velocity *= Options.StrideMultiplier;
+			Analysis.ErrorEstimate *= Options.StrideMultiplier;
 		}
 
-		// Find min/max positions for X and Y
-		double MinX = DBL_MAX, MaxX = -DBL_MAX;
-		double MinY = DBL_MAX, MaxY = -DBL_MAX;
+		// Apply Role-based direction with analyzed magnitude
+		// This ensures samples don't overlap (e.g., Run_Left, Run_Forward, Run_Right all at different positions)
+		Analysis.Position = FBlendSpaceFactory::GetRolePositionFromVelocity(Role, Analysis.Velocity);
+		return Analysis;
+	}
 
-		for (int32 Key = 0; Key < NumKeys; ++Key)
-		{
-			MinX = FMath::Min(MinX, Positions[Key].X);
-			MaxX = FMath::Max(MaxX, Positions[Key].X);
-			MinY = FMath::Min(MinY, Positions[Key].Y);
-			MaxY = FMath::Max(MaxY, Positions[Key].Y);
-		}
+	// One animation of an AnalyzeSamples batch
+	struct FAnalysisJob
+	{
+		ELocomotionRole Role = ELocomotionRole::Idle;
+		UAnimSequence* Animation = nullptr;
+		FBlendSpaceAnalysisResult Analysis;
 
-		// Stride length = max - min for each axis
-		double StrideX = MaxX - MinX;
-		double StrideY = MaxY - MinY;
+		/** Computed once per job and shared by every cache lookup and store (hashing reads the whole data model) */
+		FBlendSpaceAnalysisDerivedData::FInputHashes InputHashes;
+		bool bHasInputHashes = false;
 
-		// Velocity = Stride / PlayLength (assuming one full cycle)
-		// Note: This gives speed magnitude, we need to determine direction
-		// For locomotion, Y is forward direction, X is right direction
-		FVector CharacterVelocity;
-		CharacterVelocity.X = StrideX / PlayLength * Animation->RateScale;
-		CharacterVelocity.Y = StrideY / PlayLength * Animation->RateScale;
-		CharacterVelocity.Z = 0.f;
+		/** False when the result was already filled from the cache */
+		bool bAnalyze = true;
 
-		UE_LOG(LogBlendSpaceBuilder, Verbose, TEXT("LocomotionStride: '%s' foot '%s' -> Stride(%.1f, %.1f) Velocity(%.1f, %.1f)"),
-			*Animation->GetName(), *FootBoneName.ToString(), StrideX, StrideY, CharacterVelocity.X, CharacterVelocity.Y);
-		return CharacterVelocity;
-	}
+		/** False when the job was cancelled before it ran */
+		bool bCompleted = false;
+	};
 
-	// Calculate locomotion velocity using both feet (Simple average)
-	FVector CalculateLocomotionVelocitySimple(const UAnimSequence* Animation, FName LeftFootBone, FName RightFootBone)
+	void RunAnalysisJob(FAnalysisJob& Job, const FBlendSpaceAnalysisOptions& Options, FBlendSpaceAnalysisProgress* Progress)
 	{
-		FVector LeftVel = CalculateLocomotionVelocityFromFootSimple(Animation, LeftFootBone);
-		FVector RightVel = CalculateLocomotionVelocityFromFootSimple(Animation, RightFootBone);
-
-		int32 Count = 0;
-		FVector TotalVel = FVector::ZeroVector;
-
-		if (!LeftVel.IsNearlyZero())
+		// Results of unchanged clips come from the derived data cache (possibly computed on another machine)
+		if (Options.bBypassCache || !Job.bHasInputHashes
+			|| !FBlendSpaceAnalysisDerivedData::Get(Job.Animation, Options, Job.InputHashes, Job.Analysis))
 		{
-			TotalVel += LeftVel;
-			Count++;
+			Job.Analysis = AnalyzeSingleAnimation(Job.Animation, Options);
+			if (Job.bHasInputHashes)
+			{
+				FBlendSpaceAnalysisDerivedData::Put(Job.Animation, Options, Job.InputHashes.Requested, Job.Analysis);
+			}
 		}
-		if (!RightVel.IsNearlyZero())
+		Job.bCompleted = true;
+		if (Progress && Progress->OnSampleAnalyzed)
 		{
-			TotalVel += RightVel;
-			Count++;
+			Progress->OnSampleAnalyzed(Job.Animation, FinalizeAnalysis(Job.Role, Job.Analysis, Options));
 		}
-
-		return (Count > 0) ? TotalVel / Count : FVector::ZeroVector;
 	}
 
-	// Calculate locomotion velocity using both feet (Stride-based)
-	// Combines Simple (direction) + Stride (magnitude) for accurate results
-	FVector CalculateLocomotionVelocityStride(const UAnimSequence* Animation, FName LeftFootBone, FName RightFootBone)
+	// Analyze pending jobs concurrently. Each job only reads its animation and the immutable options
+	// and writes its own result, so the results are identical to analyzing the jobs one by one.
+	void RunAnalysisJobs(TArray<FAnalysisJob>& Jobs, const FBlendSpaceAnalysisOptions& Options, FBlendSpaceAnalysisProgress* Progress)
 	{
-		// Get direction from Simple method (accurate direction, but magnitude may be off)
-		FVector SimpleVel = CalculateLocomotionVelocitySimple(Animation, LeftFootBone, RightFootBone);
-
-		// Get magnitude from Stride method (accurate magnitude, but always positive)
-		FVector LeftStride = CalculateLocomotionVelocityFromFootStride(Animation, LeftFootBone);
-		FVector RightStride = CalculateLocomotionVelocityFromFootStride(Animation, RightFootBone);
-		FVector StrideVel = LeftStride + RightStride;  // Sum for 2-step cycle
-
-		// Combine: direction from Simple, magnitude from Stride
-		FVector Direction = SimpleVel.GetSafeNormal();
-		float Magnitude = StrideVel.Size2D();  // Use 2D magnitude (X, Y only)
+		TArray<FAnalysisJob*> Pending;
+		for (FAnalysisJob& Job : Jobs)
+		{
+			if (Job.bAnalyze)
+			{
+				Pending.Add(&Job);
+			}
+			else if (Progress && Progress->OnSampleAnalyzed)
+			{
+				Progress->OnSampleAnalyzed(Job.Animation, FinalizeAnalysis(Job.Role, Job.Analysis, Options));
+			}
+		}
 
-		FVector Result = Direction * Magnitude;
-		UE_LOG(LogBlendSpaceBuilder, Verbose, TEXT("LocomotionStride: Combined Simple dir(%.2f, %.2f) * Stride mag(%.1f) = (%.1f, %.1f)"),
-			Direction.X, Direction.Y, Magnitude, Result.X, Result.Y);
+		const int32 MaxWorkers = Options.GetSettings().MaxAnalysisWorkers > 0
+			? Options.GetSettings().MaxAnalysisWorkers
+			: FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+		const int32 NumWorkers = FMath::Min(MaxWorkers, Pending.Num());
+		if (NumWorkers <= 1)
+		{
+			for (FAnalysisJob* Job : Pending)
+			{
+				if (Progress && Progress->IsCancelled())
+				{
+					break;
+				}
+				RunAnalysisJob(*Job, Options, Progress);
+			}
+			return;
+		}
 
-		return FVector(Result.X, Result.Y, 0.f);
+		// Workers pull the next pending job until none are left
+		std::atomic<int32> NextJob = 0;
+		TArray<UE::Tasks::FTask> Workers;
+		for (int32 i = 0; i < NumWorkers; ++i)
+		{
+			Workers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Pending, &NextJob, &Options, Progress]()
+			{
+				for (int32 JobIndex = NextJob++; JobIndex < Pending.Num(); JobIndex = NextJob++)
+				{
+					if (Progress && Progress->IsCancelled())
+					{
+						break;
+					}
+					RunAnalysisJob(*Pending[JobIndex], Options, Progress);
+				}
+			}));
+		}
+		UE::Tasks::Wait(Workers);
 	}
 }
 
@@ -329,52 +1437,139 @@ UBlendSpace* FBlendSpaceFactory::CreateLocomotionBlendSpace(const FBlendSpaceBui
 	ConfigureAxes(BlendSpace, Config);
 
 	// Add samples
-	if (Config.bApplyAnalysis && Config.PreAnalyzedPositions.Num() > 0)
+	for (const auto& Pair : Config.SelectedAnimations)
 	{
-		// Use pre-analyzed positions from UI
-		for (const auto& Pair : Config.SelectedAnimations)
+		if (Pair.Value)
 		{
-			UAnimSequence* Anim = Pair.Value;
-			if (!Anim)
-			{
-				continue;
-			}
-
-			const FVector* PositionPtr = Config.PreAnalyzedPositions.Find(Anim);
-			FVector Position = PositionPtr ? *PositionPtr : FVector::ZeroVector;
-			AddSampleToBlendSpace(BlendSpace, Anim, Position);
+			AddSampleToBlendSpace(BlendSpace, Pair.Value, GetSamplePosition(Pair.Key, Pair.Value, Config));
 		}
 	}
-	else
+
+	// Save build configuration as metadata
+	SaveBuildConfigAsMetadata(BlendSpace, Config);
+
+	FinalizeAndSave(BlendSpace, Config.bDeferSave);
+
+	if (Config.bOpenInEditor)
 	{
-		// Use role-based default positions
-		for (const auto& Pair : Config.SelectedAnimations)
+		OpenAssetInEditor(BlendSpace);
+	}
+
+	return BlendSpace;
+}
+
+void FBlendSpaceFactory::QueueLocomotionBlendSpaceCreation(
+	FBlendSpaceTimeSlicedExecutor& Executor,
+	const FBlendSpaceBuildConfig& Config,
+	TFunction<void(UBlendSpace*)> OnCreated)
+{
+	// The asset is created by the first step and shared by the rest
+	struct FCreationState
+	{
+		FBlendSpaceBuildConfig Config;
+		UBlendSpace* BlendSpace = nullptr;
+
+		/** The package was on disk before the first step replaced its asset */
+		bool bReplacedExisting = false;
+
+		/** Set once every sample is in and the asset is validated and resampled */
+		bool bFinalized = false;
+	};
+	TSharedRef<FCreationState> State = MakeShared<FCreationState>();
+	State->Config = Config;
+
+	Executor.AddReferencedObject(Config.Skeleton);
+	for (const auto& Pair : Config.SelectedAnimations)
+	{
+		Executor.AddReferencedObject(Pair.Value);
+	}
+
+	Executor.AddStep([State]()
+	{
+		if (State->Config.Skeleton)
+		{
+			State->bReplacedExisting = FPackageName::DoesPackageExist(State->Config.PackagePath / State->Config.AssetName);
+			State->BlendSpace = CreateBlendSpaceAsset(State->Config.PackagePath, State->Config.AssetName, State->Config.Skeleton);
+			ConfigureAxes(State->BlendSpace, State->Config);
+		}
+	});
+
+	for (const auto& Pair : Config.SelectedAnimations)
+	{
+		if (!Pair.Value)
 		{
-			ELocomotionRole Role = Pair.Key;
-			UAnimSequence* Anim = Pair.Value;
+			continue;
+		}
 
-			if (!Anim)
+		const ELocomotionRole Role = Pair.Key;
+		UAnimSequence* Anim = Pair.Value;
+		Executor.AddStep([State, Role, Anim]()
+		{
+			if (State->BlendSpace)
 			{
-				continue;
+				AddSampleToBlendSpace(State->BlendSpace, Anim, GetSamplePosition(Role, Anim, State->Config));
 			}
+		});
+	}
 
-			FVector2D Position = GetPositionForRole(Role, Config);
-			FVector Position3D(Position.X, Position.Y, 0.f);
-			AddSampleToBlendSpace(BlendSpace, Anim, Position3D);
+	Executor.AddStep([State]()
+	{
+		if (State->BlendSpace)
+		{
+			SaveBuildConfigAsMetadata(State->BlendSpace, State->Config);
 		}
-	}
+	});
 
-	// Save build configuration as metadata
-	SaveBuildConfigAsMetadata(BlendSpace, Config);
+	Executor.AddStep([State]()
+	{
+		FinalizeBlendSpace(State->BlendSpace);
+		State->bFinalized = true;
+	});
 
-	FinalizeAndSave(BlendSpace);
+	// A cancel before finalization would leave a registered, dirty asset with only some of its samples
+	Executor.AddCancelHandler([State]()
+	{
+		if (!State->BlendSpace || State->bFinalized)
+		{
+			return;
+		}
 
-	if (Config.bOpenInEditor)
+		UBlendSpace* BlendSpace = State->BlendSpace;
+		UPackage* Package = BlendSpace->GetOutermost();
+		State->BlendSpace = nullptr;
+		if (State->bReplacedExisting)
+		{
+			// The asset on disk is intact; reloading discards the partial in-memory build
+			FText ErrorMessage;
+			UPackageTools::ReloadPackages({Package}, ErrorMessage, EReloadPackagesInteractionMode::AssumePositive);
+		}
+		else
+		{
+			ObjectTools::ForceDeleteObjects({BlendSpace}, false);
+		}
+		UE_LOG(LogBlendSpaceBuilder, Log, TEXT("Creation of %s cancelled, partial asset %s"),
+			*Package->GetName(), State->bReplacedExisting ? TEXT("reverted") : TEXT("deleted"));
+	});
+
+	if (!Config.bDeferSave)
 	{
-		OpenAssetInEditor(BlendSpace);
+		Executor.AddStep([State]()
+		{
+			SaveBlendSpace(State->BlendSpace);
+		});
 	}
 
-	return BlendSpace;
+	Executor.AddStep([State, OnCreated = MoveTemp(OnCreated)]()
+	{
+		if (State->BlendSpace && State->Config.bOpenInEditor)
+		{
+			OpenAssetInEditor(State->BlendSpace);
+		}
+		if (OnCreated)
+		{
+			OnCreated(State->BlendSpace);
+		}
+	});
 }
 
 // Get direction sign based on locomotion role
@@ -414,6 +1609,54 @@ FVector2D GetRoleDirectionSign(ELocomotionRole Role)
 	}
 }
 
+//=============================================================================
+// FBlendSpaceAnalysisSettings Implementation
+//=============================================================================
+
+TSharedRef<const FBlendSpaceAnalysisSettings> FBlendSpaceAnalysisSettings::Capture()
+{
+	check(IsInGameThread());
+
+	const UBlendSpaceBuilderSettings* Settings = UBlendSpaceBuilderSettings::Get();
+	TSharedRef<FBlendSpaceAnalysisSettings> Snapshot = MakeShared<FBlendSpaceAnalysisSettings>();
+	Snapshot->MinVelocityThreshold = Settings->MinVelocityThreshold;
+	Snapshot->FootContactHeightTolerance = Settings->FootContactHeightTolerance;
+	Snapshot->FootContactMaxVerticalSpeed = Settings->FootContactMaxVerticalSpeed;
+	Snapshot->bDetectLocomotionCycles = Settings->bDetectLocomotionCycles;
+	Snapshot->CycleDetectionMinCorrelation = Settings->CycleDetectionMinCorrelation;
+	Snapshot->SpeedCurveNames = Settings->SpeedCurveNames;
+	Snapshot->DistanceCurveNames = Settings->DistanceCurveNames;
+	Snapshot->LeftFootMarkerNames = Settings->LeftFootMarkerNames;
+	Snapshot->RightFootMarkerNames = Settings->RightFootMarkerNames;
+	Snapshot->bReuseMirroredAnalysis = Settings->bReuseMirroredAnalysis;
+	Snapshot->MirrorSignatureTolerance = Settings->MirrorSignatureTolerance;
+	Snapshot->bReuseRetargetedAnalysis = Settings->bReuseRetargetedAnalysis;
+	Snapshot->LeftFootBonePatterns = Settings->LeftFootBonePatterns;
+	Snapshot->RightFootBonePatterns = Settings->RightFootBonePatterns;
+	Snapshot->IgnorableSuffixes = Settings->IgnorableSuffixes;
+	Snapshot->MaxAnalysisWorkers = Settings->MaxAnalysisWorkers;
+	Snapshot->bUseSessionAnalysisCache = Settings->bUseSessionAnalysisCache;
+	Snapshot->bUseDerivedDataCache = Settings->bUseDerivedDataCache;
+	Snapshot->bUseAnalysisCacheFile = Settings->bUseAnalysisCacheFile;
+
+	// The mirror table is the only asset the analysis needs; it is loaded here rather than on a task
+	if (Settings->bReuseMirroredAnalysis)
+	{
+		if (const UMirrorDataTable* Table = Settings->MirrorDataTable.LoadSynchronous())
+		{
+			Snapshot->MirrorAxis = Table->MirrorAxis;
+			Table->ForeachRow<FMirrorTableRow>(TEXT("BlendSpaceBuilder"), [&Snapshot](const FName& Key, const FMirrorTableRow& Row)
+			{
+				if (Row.MirrorEntryType == EMirrorRowType::Bone)
+				{
+					Snapshot->MirrorBonePairs.Add(Row.Name, Row.MirroredName);
+				}
+			});
+		}
+	}
+	return Snapshot;
+}
+
 TMap<UAnimSequence*, FVector> FBlendSpaceFactory::AnalyzeSamplePositions(
 	const TMap<ELocomotionRole, UAnimSequence*>& Animations,
 	EBlendSpaceAnalysisType AnalysisType,
@@ -421,81 +1664,214 @@ TMap<UAnimSequence*, FVector> FBlendSpaceFactory::AnalyzeSamplePositions(
 	FName RightFootBone,
 	float StrideMultiplier)
 {
+	FBlendSpaceAnalysisOptions Options;
+	Options.AnalysisType = AnalysisType;
+	Options.LeftFootBone = LeftFootBone;
+	Options.RightFootBone = RightFootBone;
+	Options.StrideMultiplier = StrideMultiplier;
+
 	TMap<UAnimSequence*, FVector> Result;
+	for (const auto& Pair : AnalyzeSamples(Animations, Options))
+	{
+		Result.Add(Pair.Key, Pair.Value.Position);
+	}
+	return Result;
+}
+
+TMap<UAnimSequence*, FBlendSpaceAnalysisResult> FBlendSpaceFactory::AnalyzeSamples(
+	const TMap<ELocomotionRole, UAnimSequence*>& Animations,
+	const FBlendSpaceAnalysisOptions& InOptions,
+	FBlendSpaceAnalysisProgress* Progress)
+{
+	using namespace BlendSpaceAnalysisInternal;
+
+	const FBlendSpaceAnalysisOptions Options = WithSettingsSnapshot(InOptions);
+	TMap<UAnimSequence*, FBlendSpaceAnalysisResult> Result;
 
+	// Mirrored partners take the reflected result of their source instead of being analyzed
+	const TMap<UAnimSequence*, UAnimSequence*> MirroredPairs = FindMirroredPairs(Animations, Options);
+
+	// Cached results (of the clip itself, e.g. from the dialog prefetch, or of its retarget source) are
+	// looked up before any analysis runs, so reuse never depends on task order
+	const FBlendSpaceAnalysisCache& Cache = FBlendSpaceAnalysisCache::Get();
+	const bool bReuseRetargeted = Options.bReuseRetargetedAnalysis && Options.GetSettings().bReuseRetargetedAnalysis;
+	TArray<FAnalysisJob> Jobs;
 	for (const auto& Pair : Animations)
 	{
-		ELocomotionRole Role = Pair.Key;
-		UAnimSequence* Anim = Pair.Value;
-		if (!Anim)
+		if (!Pair.Value || MirroredPairs.Contains(Pair.Value))
 		{
 			continue;
 		}
 
-		// Get analyzed velocity based on analysis type
-		FVector AnalyzedVelocity;
-		switch (AnalysisType)
-		{
-		case EBlendSpaceAnalysisType::RootMotion:
-			AnalyzedVelocity = BlendSpaceAnalysisInternal::CalculateRootMotionVelocity(Anim);
-			break;
-		case EBlendSpaceAnalysisType::LocomotionSimple:
-			AnalyzedVelocity = BlendSpaceAnalysisInternal::CalculateLocomotionVelocitySimple(Anim, LeftFootBone, RightFootBone);
-			break;
-		case EBlendSpaceAnalysisType::LocomotionStride:
-			AnalyzedVelocity = BlendSpaceAnalysisInternal::CalculateLocomotionVelocityStride(Anim, LeftFootBone, RightFootBone);
-			AnalyzedVelocity *= StrideMultiplier;  // Apply multiplier for stride
-			break;
-		}
+		FAnalysisJob& Job = Jobs.AddDefaulted_GetRef();
+		Job.Role = Pair.Key;
+		Job.Animation = Pair.Value;
+	}
 
-		// Apply Role-based direction with analyzed magnitude
-		// This ensures samples don't overlap (e.g., Run_Left, Run_Forward, Run_Right all at different positions)
-		FVector2D DirSign = GetRoleDirectionSign(Role);
-		FVector Position;
+	// Hashing reads each clip's whole data model, so the lookups run in parallel like the analysis
+	ParallelFor(Jobs.Num(), [&Jobs, &Cache, &Options, bReuseRetargeted](int32 JobIndex)
+	{
+		FAnalysisJob& Job = Jobs[JobIndex];
+		Job.bHasInputHashes = FBlendSpaceAnalysisDerivedData::GetInputHashes(Job.Animation, Options, Job.InputHashes);
+		Job.bAnalyze = !(Job.bHasInputHashes && Cache.FindResult(Job.Animation, Options, Job.InputHashes, Job.Analysis))
+			&& (!bReuseRetargeted || !Cache.FindRetargetedResult(Job.Animation, Options, Job.Analysis));
+		Job.bCompleted = !Job.bAnalyze;
+	}, Jobs.Num() > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	RunAnalysisJobs(Jobs, Options, Progress);
 
-		if (DirSign.IsNearlyZero())
+	// Combine in map order
+	for (const FAnalysisJob& Job : Jobs)
+	{
+		if (!Job.bCompleted)
 		{
-			// Idle: use zero position
-			Position = FVector::ZeroVector;
+			continue;
 		}
-		else
+		if (Job.bAnalyze && Job.bHasInputHashes)
 		{
-			// Get speed magnitude from analyzed velocity (use 2D magnitude)
-			float Magnitude = AnalyzedVelocity.Size2D();
-
-			// Normalize direction and apply magnitude
-			FVector2D Dir = DirSign.GetSafeNormal();
-			Position = FVector(Dir.X * Magnitude, Dir.Y * Magnitude, 0.f);
+			FBlendSpaceAnalysisCache::Get().Store(Job.Animation, Options, Job.InputHashes.Requested, Job.Analysis);
 		}
+		Result.Add(Job.Animation, FinalizeAnalysis(Job.Role, Job.Analysis, Options));
+	}
+
+	if (MirroredPairs.Num() > 0)
+	{
+		const FMirrorSpec Spec = GetMirrorSpec(Options);
+		for (const auto& Pair : Animations)
+		{
+			UAnimSequence* const* Source = MirroredPairs.Find(Pair.Value);
+			const FBlendSpaceAnalysisResult* SourceAnalysis = Source ? Result.Find(*Source) : nullptr;
+			if (!SourceAnalysis)
+			{
+				continue;
+			}
 
-		Result.Add(Anim, Position);
+			FBlendSpaceAnalysisResult Analysis = *SourceAnalysis;
+			Analysis.Velocity = Spec.Reflect(SourceAnalysis->Velocity);
+			Analysis.Position = GetRolePositionFromVelocity(Pair.Key, Analysis.Velocity);
+			Analysis.NumKeysEvaluated = 0;
+			Analysis.MirrorSource = *Source;
+			if (Progress && Progress->OnSampleAnalyzed)
+			{
+				Progress->OnSampleAnalyzed(Pair.Value, Analysis);
+			}
+			Result.Add(Pair.Value, Analysis);
+		}
 	}
 
 	return Result;
 }
 
+TFuture<TMap<UAnimSequence*, FBlendSpaceAnalysisResult>> FBlendSpaceFactory::AnalyzeSamplesAsync(
+	const TMap<ELocomotionRole, UAnimSequence*>& Animations,
+	const FBlendSpaceAnalysisOptions& Options)
+{
+	// Snapshot taken here so the task never touches the settings object
+	return Async(EAsyncExecution::TaskGraph,
+		[Animations, Options = BlendSpaceAnalysisInternal::WithSettingsSnapshot(Options)]()
+		{
+			return AnalyzeSamples(Animations, Options);
+		});
+}
+
+FVector FBlendSpaceFactory::GetRolePositionFromVelocity(ELocomotionRole Role, const FVector& Velocity)
+{
+	FVector2D DirSign = GetRoleDirectionSign(Role);
+	if (DirSign.IsNearlyZero())
+	{
+		// Idle: use zero position
+		return FVector::ZeroVector;
+	}
+
+	// Get speed magnitude from analyzed velocity (use 2D magnitude)
+	float Magnitude = Velocity.Size2D();
+
+	// Normalize direction and apply magnitude
+	FVector2D Dir = DirSign.GetSafeNormal();
+	return FVector(Dir.X * Magnitude, Dir.Y * Magnitude, 0.f);
+}
+
 FVector FBlendSpaceFactory::AnalyzeAnimationVelocity(
 	UAnimSequence* Animation,
 	EBlendSpaceAnalysisType AnalysisType,
 	FName LeftFootBone,
 	FName RightFootBone)
 {
-	if (!Animation)
+	FBlendSpaceAnalysisOptions Options;
+	Options.AnalysisType = AnalysisType;
+	Options.LeftFootBone = LeftFootBone;
+	Options.RightFootBone = RightFootBone;
+	return AnalyzeAnimation(Animation, Options).Velocity;
+}
+
+FBlendSpaceAnalysisResult FBlendSpaceFactory::AnalyzeAnimation(UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options)
+{
+	return BlendSpaceAnalysisInternal::AnalyzeSingleAnimation(Animation, BlendSpaceAnalysisInternal::WithSettingsSnapshot(Options));
+}
+
+float FBlendSpaceFactory::GetSkeletonLegLength(const USkeleton* Skeleton)
+{
+	const UBlendSpaceBuilderSettings* Settings = UBlendSpaceBuilderSettings::Get();
+	return GetSkeletonLegLength(Skeleton, Settings->FindLeftFootBone(Skeleton), Settings->FindRightFootBone(Skeleton));
+}
+
+float FBlendSpaceFactory::GetSkeletonLegLength(const USkeleton* Skeleton, FName LeftFootBone, FName RightFootBone)
+{
+	if (!Skeleton)
 	{
-		return FVector::ZeroVector;
+		return 0.f;
 	}
 
-	switch (AnalysisType)
+	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+	const int32 LeftFoot = RefSkeleton.FindBoneIndex(LeftFootBone);
+	const int32 RightFoot = RefSkeleton.FindBoneIndex(RightFootBone);
+	if (LeftFoot == INDEX_NONE || RightFoot == INDEX_NONE || LeftFoot == RightFoot)
 	{
-	case EBlendSpaceAnalysisType::RootMotion:
-		return BlendSpaceAnalysisInternal::CalculateRootMotionVelocity(Animation);
-	case EBlendSpaceAnalysisType::LocomotionSimple:
-		return BlendSpaceAnalysisInternal::CalculateLocomotionVelocitySimple(Animation, LeftFootBone, RightFootBone);
-	case EBlendSpaceAnalysisType::LocomotionStride:
-		return BlendSpaceAnalysisInternal::CalculateLocomotionVelocityStride(Animation, LeftFootBone, RightFootBone);
-	default:
-		return FVector::ZeroVector;
+		return 0.f;
+	}
+
+	// Bone shared by both legs (pelvis)
+	TSet<int32> LeftChain;
+	for (int32 Bone = LeftFoot; Bone != INDEX_NONE; Bone = RefSkeleton.GetParentIndex(Bone))
+	{
+		LeftChain.Add(Bone);
 	}
+	int32 Pelvis = RightFoot;
+	while (Pelvis != INDEX_NONE && !LeftChain.Contains(Pelvis))
+	{
+		Pelvis = RefSkeleton.GetParentIndex(Pelvis);
+	}
+	if (Pelvis == INDEX_NONE)
+	{
+		return 0.f;
+	}
+
+	auto GetLegLength = [&RefSkeleton, Pelvis](int32 Foot)
+	{
+		int32 Hip = Foot;
+		while (RefSkeleton.GetParentIndex(Hip) != Pelvis && RefSkeleton.GetParentIndex(Hip) != INDEX_NONE)
+		{
+			Hip = RefSkeleton.GetParentIndex(Hip);
+		}
+		const FVector FootPosition = BlendSpaceAnalysisInternal::GetRefPoseComponentSpaceTransform(RefSkeleton, Foot).GetTranslation();
+		const FVector HipPosition = BlendSpaceAnalysisInternal::GetRefPoseComponentSpaceTransform(RefSkeleton, Hip).GetTranslation();
+		return float(FVector::Dist(FootPosition, HipPosition));
+	};
+
+	return 0.5f * (GetLegLength(LeftFoot) + GetLegLength(RightFoot));
+}
+
+float FBlendSpaceFactory::GetAutoScaleDivisor(const USkeleton* Skeleton)
+{
+	const float LegLength = GetSkeletonLegLength(Skeleton);
+	const float ReferenceLegLength = UBlendSpaceBuilderSettings::Get()->ReferenceLegLength;
+	if (LegLength <= KINDA_SMALL_NUMBER || ReferenceLegLength <= KINDA_SMALL_NUMBER)
+	{
+		return 1.f;
+	}
+
+	// Characters of other proportions keep their measured speed; only unit mismatches are normalized
+	return FMath::Pow(10.f, FMath::RoundToFloat(FMath::LogX(10.f, LegLength / ReferenceLegLength)));
 }
 
 void FBlendSpaceFactory::CalculateAxisRangeFromAnalysis(
@@ -696,6 +2072,7 @@ void FBlendSpaceFactory::SaveBuildConfigAsMetadata(UBlendSpace* BlendSpace, cons
 	// Store analysis settings
 	UserData->bApplyAnalysis = Config.bApplyAnalysis;
 	UserData->AnalysisType = Config.AnalysisType;
+	UserData->ContactBones = Config.ContactBoneNames;
 	UserData->GridDivisions = Config.GridDivisions;
 	UserData->bSnapToGrid = Config.bSnapToGrid;
 
@@ -768,7 +2145,16 @@ void FBlendSpaceFactory::SaveBuildConfigAsMetadata(UBlendSpace* BlendSpace, cons
 		*BlendSpace->GetName(), UserData->WalkSpeed, UserData->RunSpeed, UserData->SprintSpeed);
 }
 
-void FBlendSpaceFactory::FinalizeAndSave(UBlendSpace* BlendSpace)
+void FBlendSpaceFactory::FinalizeAndSave(UBlendSpace* BlendSpace, bool bDeferSave)
+{
+	FinalizeBlendSpace(BlendSpace);
+	if (!bDeferSave)
+	{
+		SaveBlendSpace(BlendSpace);
+	}
+}
+
+void FBlendSpaceFactory::FinalizeBlendSpace(UBlendSpace* BlendSpace)
 {
 	if (!BlendSpace)
 	{
@@ -782,18 +2168,21 @@ void FBlendSpaceFactory::FinalizeAndSave(UBlendSpace* BlendSpace)
 	BlendSpace->Modify();
 	BlendSpace->PostEditChange();
 	BlendSpace->MarkPackageDirty();
+}
 
-	UPackage* Package = BlendSpace->GetOutermost();
-	FString PackageFilename;
-	if (FPackageName::TryConvertLongPackageNameToFilename(Package->GetName(), PackageFilename, FPackageName::GetAssetPackageExtension()))
+void FBlendSpaceFactory::SaveBlendSpace(UBlendSpace* BlendSpace)
+{
+	if (!BlendSpace)
 	{
-		FSavePackageArgs SaveArgs;
-		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-		UPackage::SavePackage(Package, BlendSpace, *PackageFilename, SaveArgs);
+		return;
 	}
 
+	const EBlendSpacePackageSaveResult SaveResult = FBlendSpacePackageSaver::SavePackage(BlendSpace->GetOutermost());
+
 	FNotificationInfo Info(FText::Format(
-		LOCTEXT("BlendSpaceCreated", "Created BlendSpace: {0}"),
+		SaveResult == EBlendSpacePackageSaveResult::Unchanged
+			? LOCTEXT("BlendSpaceUnchanged", "BlendSpace unchanged, not rewritten: {0}")
+			: LOCTEXT("BlendSpaceCreated", "Created BlendSpace: {0}"),
 		FText::FromString(BlendSpace->GetName())));
 	Info.ExpireDuration = 5.0f;
 	Info.bUseSuccessFailIcons = true;
@@ -804,6 +2193,20 @@ void FBlendSpaceFactory::FinalizeAndSave(UBlendSpace* BlendSpace)
 	}
 }
 
+FVector FBlendSpaceFactory::GetSamplePosition(ELocomotionRole Role, UAnimSequence* Animation, const FBlendSpaceBuildConfig& Config)
+{
+	// Use pre-analyzed positions from UI
+	if (Config.bApplyAnalysis && Config.PreAnalyzedPositions.Num() > 0)
+	{
+		const FVector* PositionPtr = Config.PreAnalyzedPositions.Find(Animation);
+		return PositionPtr ? *PositionPtr : FVector::ZeroVector;
+	}
+
+	// Use role-based default positions
+	const FVector2D Position = GetPositionForRole(Role, Config);
+	return FVector(Position.X, Position.Y, 0.f);
+}
+
 FVector2D FBlendSpaceFactory::GetPositionForRole(ELocomotionRole Role, const FBlendSpaceBuildConfig& Config)
 {
 	// Gait-based mode uses fixed positions based on role
@@ -1,5 +1,6 @@
 #include "BlendSpaceGaitConverter.h"
 #include "BlendSpaceConfigAssetUserData.h"
+#include "BlendSpaceTimeSlicedExecutor.h"
 
 #include "Animation/BlendSpace.h"
 #include "Animation/AnimSequence.h"
@@ -8,12 +9,13 @@
 #include "AssetToolsModule.h"
 #include "IAssetTools.h"
 #include "UObject/Package.h"
-#include "UObject/SavePackage.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "Editor.h"
 #include "Subsystems/AssetEditorSubsystem.h"
 #include "ObjectTools.h"
+#include "BlendSpacePackageSaver.h"
+#include "Async/ParallelFor.h"
 
 #define LOCTEXT_NAMESPACE "BlendSpaceGaitConverter"
 
@@ -159,6 +161,49 @@ UBlendSpace* FBlendSpaceGaitConverter::ConvertToGaitBased(
 		return nullptr;
 	}
 
+	UBlendSpace* TargetBS = ApplyConversion(Source, Config, OutResult);
+	if (!TargetBS)
+	{
+		return nullptr;
+	}
+
+	// Save package to ensure grid data is serialized correctly (deferred saves are the caller's)
+	if (!Config.bDeferSave)
+	{
+		FBlendSpacePackageSaver::SavePackage(TargetBS->GetOutermost());
+	}
+
+	// Open in editor if requested
+	if (Config.bOpenInEditor && GEditor)
+	{
+		UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+		if (AssetEditorSubsystem)
+		{
+			AssetEditorSubsystem->OpenEditorForAsset(TargetBS);
+		}
+	}
+
+	// Show notification
+	FNotificationInfo Info(FText::Format(
+		LOCTEXT("GaitConversionSuccess", "Converted BlendSpace to Gait-based: {0}"),
+		FText::FromString(TargetBS->GetName())));
+	Info.ExpireDuration = 5.0f;
+	Info.bUseSuccessFailIcons = true;
+	TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info);
+	if (Notification.IsValid())
+	{
+		Notification->SetCompletionState(SNotificationItem::CS_Success);
+	}
+
+	OutResult.bSuccess = true;
+	return TargetBS;
+}
+
+UBlendSpace* FBlendSpaceGaitConverter::ApplyConversion(
+	UBlendSpace* Source,
+	const FGaitConversionConfig& Config,
+	FGaitConversionResult& InOutResult)
+{
 	// Create copy or use original
 	UBlendSpace* TargetBS = nullptr;
 	if (Config.bCreateCopy)
@@ -166,8 +211,8 @@ UBlendSpace* FBlendSpaceGaitConverter::ConvertToGaitBased(
 		TargetBS = CreateBlendSpaceCopy(Source, Config.OutputSuffix);
 		if (!TargetBS)
 		{
-			OutResult.bSuccess = false;
-			OutResult.ErrorMessage = TEXT("Failed to create BlendSpace copy");
+			InOutResult.bSuccess = false;
+			InOutResult.ErrorMessage = TEXT("Failed to create BlendSpace copy");
 			return nullptr;
 		}
 	}
@@ -178,9 +223,7 @@ UBlendSpace* FBlendSpaceGaitConverter::ConvertToGaitBased(
 		TargetBS->Modify();
 	}
 
-	// Re-analyze target to get correct animation references after copy
-	FGaitConversionResult TargetAnalysis = AnalyzeBlendSpace(TargetBS, Config);
-
+	// A copy references the same animations, so the source analysis maps its samples as well
 	// Update sample positions first (before changing axes)
 	FProperty* SampleDataProperty = UBlendSpace::StaticClass()->FindPropertyByName(TEXT("SampleData"));
 	if (SampleDataProperty)
@@ -197,7 +240,7 @@ UBlendSpace* FBlendSpaceGaitConverter::ConvertToGaitBased(
 				}
 
 				// Find the new Gait position for this animation
-				if (const FVector2D* NewPos = TargetAnalysis.NewGaitPositions.Find(Anim))
+				if (const FVector2D* NewPos = InOutResult.NewGaitPositions.Find(Anim))
 				{
 					Sample.SampleValue.X = NewPos->X;
 					Sample.SampleValue.Y = NewPos->Y;
@@ -210,9 +253,9 @@ UBlendSpace* FBlendSpaceGaitConverter::ConvertToGaitBased(
 	ConfigureGaitAxes(TargetBS);
 
 	// Save conversion metadata
-	SaveConversionMetadata(TargetBS, TargetAnalysis,
-		OutResult.OriginalXMin, OutResult.OriginalXMax,
-		OutResult.OriginalYMin, OutResult.OriginalYMax);
+	SaveConversionMetadata(TargetBS, InOutResult,
+		InOutResult.OriginalXMin, InOutResult.OriginalXMax,
+		InOutResult.OriginalYMin, InOutResult.OriginalYMax);
 
 	// Validate and resample - ResampleData recalculates internal grid/triangle data
 	TargetBS->ValidateSampleData();
@@ -220,42 +263,102 @@ UBlendSpace* FBlendSpaceGaitConverter::ConvertToGaitBased(
 	TargetBS->PostEditChange();
 	TargetBS->MarkPackageDirty();
 
-	// Always save package to ensure grid data is serialized correctly
+	return TargetBS;
+}
+
+void FBlendSpaceGaitConverter::ConvertBatch(const TArray<UBlendSpace*>& BlendSpaces, const FGaitConversionConfig& Config)
+{
+	// Phase 1: role inference and position remapping for every asset at once. Each analysis only
+	// reads its own BlendSpace, and the game thread waits here, so nothing edits them meanwhile.
+	TArray<FGaitConversionResult> Analyses;
+	Analyses.SetNum(BlendSpaces.Num());
+	ParallelFor(BlendSpaces.Num(), [&BlendSpaces, &Config, &Analyses](int32 Index)
 	{
-		UPackage* Package = TargetBS->GetOutermost();
-		FString PackageFilename;
-		if (FPackageName::TryConvertLongPackageNameToFilename(Package->GetName(), PackageFilename, FPackageName::GetAssetPackageExtension()))
+		Analyses[Index] = AnalyzeBlendSpace(BlendSpaces[Index], Config);
+	});
+
+	ConvertBatch(BlendSpaces, MoveTemp(Analyses), Config);
+}
+
+void FBlendSpaceGaitConverter::ConvertBatch(const TArray<UBlendSpace*>& BlendSpaces, TArray<FGaitConversionResult> Analyses, const FGaitConversionConfig& Config)
+{
+	check(Analyses.Num() == BlendSpaces.Num());
+
+	struct FBatchState
+	{
+		TArray<FGaitConversionResult> Analyses;
+		TArray<UBlendSpace*> ConvertedBlendSpaces;
+		FBlendSpacePackageSaver Saver;
+		int32 FailCount = 0;
+	};
+	TSharedRef<FBatchState> State = MakeShared<FBatchState>();
+	State->Analyses = MoveTemp(Analyses);
+
+	// Phase 2: mutation and resampling on the game thread, one BlendSpace per step over editor frames
+	TSharedRef<FBlendSpaceTimeSlicedExecutor> Executor = MakeShared<FBlendSpaceTimeSlicedExecutor>(
+		LOCTEXT("ConvertingToGaitBased", "Converting to Gait-based"));
+	for (int32 Index = 0; Index < BlendSpaces.Num(); ++Index)
+	{
+		UBlendSpace* BlendSpace = BlendSpaces[Index];
+		Executor->AddReferencedObject(BlendSpace);
+		Executor->AddStep([BlendSpace, Index, Config, State]()
 		{
-			FSavePackageArgs SaveArgs;
-			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-			UPackage::SavePackage(Package, TargetBS, *PackageFilename, SaveArgs);
-		}
-	}
+			FGaitConversionResult& Analysis = State->Analyses[Index];
+			UBlendSpace* ConvertedBlendSpace = Analysis.bSuccess ? ApplyConversion(BlendSpace, Config, Analysis) : nullptr;
+			if (ConvertedBlendSpace)
+			{
+				State->ConvertedBlendSpaces.Add(ConvertedBlendSpace);
+				State->Saver.Add(ConvertedBlendSpace);
+			}
+			else
+			{
+				UE_LOG(LogGaitConverter, Warning, TEXT("Gait conversion of %s failed: %s"), *BlendSpace->GetName(), *Analysis.ErrorMessage);
+				State->FailCount++;
+			}
+		});
 
-	// Open in editor if requested
-	if (Config.bOpenInEditor && GEditor)
-	{
-		UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-		if (AssetEditorSubsystem)
+		// New copies are serialized as their own step so the file write overlaps with converting the next
+		// BlendSpace; in-place conversions are held back and checked out together when the batch completes
+		Executor->AddStep([State]()
 		{
-			AssetEditorSubsystem->OpenEditorForAsset(TargetBS);
-		}
+			State->Saver.SavePending();
+		});
 	}
 
-	// Show notification
-	FNotificationInfo Info(FText::Format(
-		LOCTEXT("GaitConversionSuccess", "Converted BlendSpace to Gait-based: {0}"),
-		FText::FromString(TargetBS->GetName())));
-	Info.ExpireDuration = 5.0f;
-	Info.bUseSuccessFailIcons = true;
-	TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info);
-	if (Notification.IsValid())
+	// Phase 3: save the in-place conversions with checkout and wait for the background writes
+	// (also after a cancel, so converted assets are never left unsaved)
+	Executor->OnCompleted().BindLambda([State, Config](bool bCancelled)
 	{
-		Notification->SetCompletionState(SNotificationItem::CS_Success);
-	}
+		State->Saver.SavePending();
+		State->Saver.Wait();
 
-	OutResult.bSuccess = true;
-	return TargetBS;
+		if (Config.bOpenInEditor && GEditor)
+		{
+			if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+			{
+				for (UBlendSpace* BlendSpace : State->ConvertedBlendSpaces)
+				{
+					AssetEditorSubsystem->OpenEditorForAsset(BlendSpace);
+				}
+			}
+		}
+
+		// Show notification
+		FNotificationInfo Info(FText::Format(
+			LOCTEXT("BatchConvertResult", "Converted {0} BlendSpace(s) to Gait-based ({1} failed): {2} written, {3} unchanged"),
+			FText::AsNumber(State->ConvertedBlendSpaces.Num()),
+			FText::AsNumber(State->FailCount),
+			FText::AsNumber(State->Saver.GetNumWritten()),
+			FText::AsNumber(State->Saver.GetNumUnchanged())));
+		Info.ExpireDuration = 5.0f;
+		Info.bUseSuccessFailIcons = true;
+		TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info);
+		if (Notification.IsValid())
+		{
+			Notification->SetCompletionState(State->FailCount == 0 && !bCancelled ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		}
+	});
+	Executor->Start();
 }
 
 ELocomotionRole FBlendSpaceGaitConverter::InferRoleFromSpeedPosition(
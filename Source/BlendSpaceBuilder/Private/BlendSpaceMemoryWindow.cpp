@@ -0,0 +1,152 @@
+#include "BlendSpaceMemoryWindow.h"
+#include "BlendSpaceBuilderSettings.h"
+
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectGlobals.h"
+#include "HAL/PlatformMemory.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBlendSpaceMemoryWindow, Log, All);
+
+namespace BlendSpaceMemoryWindowInternal
+{
+	uint64 GetUsedMemory()
+	{
+		return FPlatformMemory::GetStats().UsedPhysical;
+	}
+}
+
+FBlendSpaceMemoryWindow::FLoadScope::FLoadScope(FBlendSpaceMemoryWindow& InWindow)
+	: Window(InWindow)
+{
+	check(IsInGameThread());
+
+	if (Window.IsEnabled())
+	{
+		EndLoadPackageHandle = FCoreUObjectDelegates::OnEndLoadPackage.AddRaw(this, &FLoadScope::OnEndLoadPackage);
+	}
+}
+
+FBlendSpaceMemoryWindow::FLoadScope::~FLoadScope()
+{
+	FCoreUObjectDelegates::OnEndLoadPackage.Remove(EndLoadPackageHandle);
+}
+
+void FBlendSpaceMemoryWindow::FLoadScope::OnEndLoadPackage(const FEndLoadPackageContext& Context)
+{
+	// The scope only spans a synchronous batch step, so every load that finishes inside it is the batch's
+	for (UPackage* Package : Context.LoadedPackages)
+	{
+		Window.AddPackage(Package);
+	}
+}
+
+FBlendSpaceMemoryWindow::FBlendSpaceMemoryWindow()
+	: FBlendSpaceMemoryWindow(UBlendSpaceBuilderSettings::Get()->BatchMemoryBudgetMB)
+{
+}
+
+FBlendSpaceMemoryWindow::FBlendSpaceMemoryWindow(int32 InBudgetMB)
+	: BudgetMB(FMath::Max(InBudgetMB, 0))
+{
+	check(IsInGameThread());
+
+	WindowStartMemory = BlendSpaceMemoryWindowInternal::GetUsedMemory();
+}
+
+bool FBlendSpaceMemoryWindow::IsOverBudget() const
+{
+	const uint64 UsedMemory = BlendSpaceMemoryWindowInternal::GetUsedMemory();
+	return IsEnabled() && UsedMemory > WindowStartMemory && (UsedMemory - WindowStartMemory) / (1024 * 1024) > uint64(BudgetMB);
+}
+
+bool FBlendSpaceMemoryWindow::IsReleasable(const UPackage* Package) const
+{
+	return Package != GetTransientPackage()
+		&& !Package->HasAnyPackageFlags(PKG_CompiledIn | PKG_ContainsMap)
+		&& BatchPackages.Contains(Package->GetFName());
+}
+
+void FBlendSpaceMemoryWindow::AddPackage(const UPackage* Package)
+{
+	if (Package && IsEnabled())
+	{
+		BatchPackages.Add(Package->GetFName());
+	}
+}
+
+void FBlendSpaceMemoryWindow::Release()
+{
+	using namespace BlendSpaceMemoryWindowInternal;
+	check(IsInGameThread());
+
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	const uint64 MemoryBefore = GetUsedMemory();
+
+	// Loaded assets are standalone and survive garbage collection. Dropping the flag lets the collector free
+	// those nothing references any more; assets still in use (open editors, work in flight) are kept.
+	TArray<TWeakObjectPtr<UObject>> StandaloneObjects;
+	for (const FName PackageName : BatchPackages)
+	{
+		UPackage* Package = FindObjectFast<UPackage>(nullptr, PackageName);
+		if (!Package || Package->IsDirty() || !IsReleasable(Package))
+		{
+			continue;
+		}
+
+		ForEachObjectWithPackage(Package, [&StandaloneObjects](UObject* Object)
+		{
+			if (Object->HasAnyFlags(RF_Standalone))
+			{
+				Object->ClearFlags(RF_Standalone);
+				StandaloneObjects.Add(Object);
+			}
+			return true;
+		}, false);
+	}
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	// Survivors are assets again once nothing holds them
+	int32 NumReleased = 0;
+	for (const TWeakObjectPtr<UObject>& Object : StandaloneObjects)
+	{
+		if (UObject* Survivor = Object.Get())
+		{
+			Survivor->SetFlags(RF_Standalone);
+		}
+		else
+		{
+			++NumReleased;
+		}
+	}
+
+	// Released packages are forgotten, so one the user loads again later is never the batch's
+	for (auto It = BatchPackages.CreateIterator(); It; ++It)
+	{
+		if (!FindObjectFast<UPackage>(nullptr, *It))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	++NumReleasedWindows;
+	WindowStartMemory = GetUsedMemory();
+	UE_LOG(LogBlendSpaceMemoryWindow, Log, TEXT("Window %d: released %d asset(s), %llu MB -> %llu MB"),
+		NumReleasedWindows, NumReleased, MemoryBefore / (1024 * 1024), WindowStartMemory / (1024 * 1024));
+}
+
+bool FBlendSpaceMemoryWindow::ReleaseIfOverBudget()
+{
+	if (!IsOverBudget())
+	{
+		return false;
+	}
+
+	Release();
+	return true;
+}
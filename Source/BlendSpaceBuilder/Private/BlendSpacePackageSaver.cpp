@@ -0,0 +1,223 @@
+#include "BlendSpacePackageSaver.h"
+#include "BlendSpaceBuilderSettings.h"
+
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "Misc/PackageName.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "FileHelpers.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBlendSpacePackageSaver, Log, All);
+
+namespace BlendSpacePackageSaverInternal
+{
+	/** Scratch file a package is serialized to for comparison (outside Content, so never picked up as an asset) */
+	FString GetStagingFilename(const UPackage* Package)
+	{
+		return FPaths::ProjectSavedDir() / TEXT("BlendSpaceBuilder") / TEXT("SaveStaging")
+			/ Package->GetName().Replace(TEXT("/"), TEXT("_")) + FPackageName::GetAssetPackageExtension();
+	}
+
+	bool AreFilesIdentical(const FString& FilenameA, const FString& FilenameB)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		const int64 Size = FileManager.FileSize(*FilenameA);
+		if (Size < 0 || Size != FileManager.FileSize(*FilenameB))
+		{
+			return false;
+		}
+
+		TArray64<uint8> BytesA;
+		TArray64<uint8> BytesB;
+		return FFileHelper::LoadFileToArray(BytesA, *FilenameA)
+			&& FFileHelper::LoadFileToArray(BytesB, *FilenameB)
+			&& BytesA.Num() == BytesB.Num()
+			&& FMemory::Memcmp(BytesA.GetData(), BytesB.GetData(), BytesA.Num()) == 0;
+	}
+
+	bool SaveNewPackage(UPackage* Package, const FString& PackageFilename, bool bAsync)
+	{
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = bAsync ? SAVE_Async : SAVE_None;
+		const bool bSaved = UPackage::SavePackage(Package, Package->FindAssetInPackage(), *PackageFilename, SaveArgs);
+		if (!bSaved)
+		{
+			UE_LOG(LogBlendSpacePackageSaver, Warning, TEXT("Failed to save %s"), *Package->GetName());
+		}
+		return bSaved;
+	}
+
+	/** Serialize the package to a staging file and compare it with what is on disk; the package stays dirty */
+	bool IsUnchangedOnDisk(UPackage* Package, const FString& PackageFilename)
+	{
+		const FString StagingFilename = GetStagingFilename(Package);
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_KeepDirty | SAVE_NoError;
+		const bool bStaged = UPackage::SavePackage(Package, Package->FindAssetInPackage(), *StagingFilename, SaveArgs);
+		const bool bUnchanged = bStaged && AreFilesIdentical(StagingFilename, PackageFilename);
+
+		IFileManager::Get().Delete(*StagingFilename, false, false, true);
+		return bUnchanged;
+	}
+
+	/**
+	 * Write a new package directly and detect an existing one whose content is unchanged.
+	 * Returns false for an existing package that changed: only the editor save may write it.
+	 */
+	bool TrySaveWithoutCheckout(UPackage* Package, bool bAsync, EBlendSpacePackageSaveResult& OutResult)
+	{
+		FString PackageFilename;
+		if (!Package || !FPackageName::TryConvertLongPackageNameToFilename(Package->GetName(), PackageFilename, FPackageName::GetAssetPackageExtension()))
+		{
+			OutResult = EBlendSpacePackageSaveResult::Failed;
+			return true;
+		}
+
+		// New packages are not under source control yet, so the raw (optionally async) path writes them
+		if (!IFileManager::Get().FileExists(*PackageFilename))
+		{
+			OutResult = SaveNewPackage(Package, PackageFilename, bAsync) ? EBlendSpacePackageSaveResult::Written : EBlendSpacePackageSaveResult::Failed;
+			return true;
+		}
+
+		// Regenerating with identical inputs must not touch the file (timestamps, source control, cooks),
+		// so the comparison runs before anything is checked out
+		if (GetDefault<UBlendSpaceBuilderSettings>()->bSkipUnchangedPackages && IsUnchangedOnDisk(Package, PackageFilename))
+		{
+			Package->SetDirtyFlag(false);
+			UE_LOG(LogBlendSpacePackageSaver, Log, TEXT("%s is unchanged, not written"), *Package->GetName());
+			OutResult = EBlendSpacePackageSaveResult::Unchanged;
+			return true;
+		}
+		return false;
+	}
+
+	/** Save existing packages through the editor, which checks them out of source control (one prompt for all) and handles read-only files */
+	void SaveWithCheckout(const TArray<UPackage*>& Packages, TArray<EBlendSpacePackageSaveResult>& OutResults)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(Packages, false);
+
+		OutResults.Reset(Packages.Num());
+		for (UPackage* Package : Packages)
+		{
+			const bool bSaved = !Package->IsDirty();
+			if (!bSaved)
+			{
+				UE_LOG(LogBlendSpacePackageSaver, Warning, TEXT("Failed to save %s (not checked out or read-only?)"), *Package->GetName());
+			}
+			OutResults.Add(bSaved ? EBlendSpacePackageSaveResult::Written : EBlendSpacePackageSaveResult::Failed);
+		}
+	}
+}
+
+FBlendSpacePackageSaver::~FBlendSpacePackageSaver()
+{
+	// Never leave writes of this batch running past its owner (held-back packages stay dirty for the user)
+	if (bWritesPending)
+	{
+		UPackage::WaitForAsyncFileWrites();
+	}
+}
+
+void FBlendSpacePackageSaver::Add(UObject* Asset)
+{
+	if (Asset)
+	{
+		Packages.AddUnique(Asset->GetOutermost());
+	}
+}
+
+void FBlendSpacePackageSaver::SavePending()
+{
+	using namespace BlendSpacePackageSaverInternal;
+
+	check(IsInGameThread());
+
+	for (; NextPackage < Packages.Num(); ++NextPackage)
+	{
+		UPackage* Package = Packages[NextPackage].Get();
+		EBlendSpacePackageSaveResult Result;
+		if (TrySaveWithoutCheckout(Package, true, Result))
+		{
+			CountResult(Result);
+		}
+		else
+		{
+			// Held back so the whole batch is checked out in one go by Wait
+			CheckoutPackages.Add(Package);
+		}
+	}
+}
+
+void FBlendSpacePackageSaver::Wait()
+{
+	using namespace BlendSpacePackageSaverInternal;
+
+	TArray<UPackage*> PackagesToCheckOut;
+	for (const TWeakObjectPtr<UPackage>& Package : CheckoutPackages)
+	{
+		if (Package.IsValid())
+		{
+			PackagesToCheckOut.Add(Package.Get());
+		}
+		else
+		{
+			++NumFailed;
+		}
+	}
+	CheckoutPackages.Reset();
+
+	if (PackagesToCheckOut.Num() > 0)
+	{
+		TArray<EBlendSpacePackageSaveResult> Results;
+		SaveWithCheckout(PackagesToCheckOut, Results);
+		for (EBlendSpacePackageSaveResult Result : Results)
+		{
+			CountResult(Result);
+		}
+	}
+
+	if (bWritesPending)
+	{
+		UPackage::WaitForAsyncFileWrites();
+		bWritesPending = false;
+	}
+}
+
+void FBlendSpacePackageSaver::CountResult(EBlendSpacePackageSaveResult Result)
+{
+	switch (Result)
+	{
+	case EBlendSpacePackageSaveResult::Written:
+		++NumWritten;
+		bWritesPending = true;
+		break;
+	case EBlendSpacePackageSaveResult::Unchanged:
+		++NumUnchanged;
+		break;
+	case EBlendSpacePackageSaveResult::Failed:
+		++NumFailed;
+		break;
+	}
+}
+
+EBlendSpacePackageSaveResult FBlendSpacePackageSaver::SavePackage(UPackage* Package, bool bAsync)
+{
+	using namespace BlendSpacePackageSaverInternal;
+
+	check(IsInGameThread());
+
+	EBlendSpacePackageSaveResult Result;
+	if (!TrySaveWithoutCheckout(Package, bAsync, Result))
+	{
+		TArray<EBlendSpacePackageSaveResult> Results;
+		SaveWithCheckout({Package}, Results);
+		Result = Results[0];
+	}
+	return Result;
+}
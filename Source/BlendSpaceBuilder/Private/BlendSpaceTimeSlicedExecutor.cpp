@@ -0,0 +1,149 @@
+#include "BlendSpaceTimeSlicedExecutor.h"
+#include "BlendSpaceBuilderSettings.h"
+
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "BlendSpaceTimeSlicedExecutor"
+
+FBlendSpaceTimeSlicedExecutor::FBlendSpaceTimeSlicedExecutor(const FText& InDescription)
+	: Description(InDescription)
+{
+}
+
+void FBlendSpaceTimeSlicedExecutor::AddStep(TFunction<void()> Step)
+{
+	check(!IsRunning());
+	Steps.Add(MoveTemp(Step));
+}
+
+void FBlendSpaceTimeSlicedExecutor::AddCancelHandler(TFunction<void()> Handler)
+{
+	check(!IsRunning());
+	CancelHandlers.Add(MoveTemp(Handler));
+}
+
+void FBlendSpaceTimeSlicedExecutor::AddReferencedObject(UObject* Object)
+{
+	if (Object)
+	{
+		ReferencedObjects.AddUnique(Object);
+	}
+}
+
+void FBlendSpaceTimeSlicedExecutor::Start()
+{
+	check(IsInGameThread());
+	if (IsRunning())
+	{
+		return;
+	}
+
+	BudgetSeconds = FMath::Max(UBlendSpaceBuilderSettings::Get()->TimeSliceBudgetMs, 1.f) / 1000.0;
+	if (Steps.Num() == 0)
+	{
+		Finish();
+		return;
+	}
+
+	TSharedRef<FBlendSpaceTimeSlicedExecutor> This = AsShared();
+	if (bShowNotification)
+	{
+		AddNotification();
+	}
+
+	// The ticker holds the executor until the last step has run
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([This](float DeltaTime)
+	{
+		return This->Tick(DeltaTime);
+	}));
+}
+
+void FBlendSpaceTimeSlicedExecutor::AddNotification()
+{
+	TSharedRef<FBlendSpaceTimeSlicedExecutor> This = AsShared();
+	FNotificationInfo Info(Description);
+	Info.Text = TAttribute<FText>::CreateSP(This, &FBlendSpaceTimeSlicedExecutor::GetProgressText);
+	Info.bFireAndForget = false;
+	Info.bUseThrobber = true;
+	Info.bUseSuccessFailIcons = true;
+	Info.ButtonDetails.Add(FNotificationButtonInfo(
+		LOCTEXT("Cancel", "Cancel"),
+		LOCTEXT("CancelTip", "Skip the remaining steps"),
+		FSimpleDelegate::CreateSP(This, &FBlendSpaceTimeSlicedExecutor::Cancel),
+		SNotificationItem::CS_Pending));
+	Notification = FSlateNotificationManager::Get().AddNotification(Info);
+	if (TSharedPtr<SNotificationItem> Item = Notification.Pin())
+	{
+		Item->SetCompletionState(SNotificationItem::CS_Pending);
+	}
+}
+
+void FBlendSpaceTimeSlicedExecutor::Cancel()
+{
+	bCancelled = true;
+}
+
+bool FBlendSpaceTimeSlicedExecutor::Tick(float DeltaTime)
+{
+	// Always make progress, even when a single step exceeds the budget
+	const double StartTime = FPlatformTime::Seconds();
+	while (!bCancelled && NextStep < Steps.Num())
+	{
+		Steps[NextStep++]();
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	if (bCancelled || NextStep >= Steps.Num())
+	{
+		Finish();
+		return false;
+	}
+	return true;
+}
+
+void FBlendSpaceTimeSlicedExecutor::Finish()
+{
+	TickerHandle.Reset();
+
+	if (TSharedPtr<SNotificationItem> Item = Notification.Pin())
+	{
+		Item->SetText(GetProgressText());
+		Item->SetCompletionState(bCancelled ? SNotificationItem::CS_Fail : SNotificationItem::CS_Success);
+		Item->ExpireAndFadeout();
+	}
+
+	if (bCancelled)
+	{
+		for (const TFunction<void()>& Handler : CancelHandlers)
+		{
+			Handler();
+		}
+	}
+
+	OnCompletedDelegate.ExecuteIfBound(bCancelled);
+
+	// Release captured state
+	Steps.Empty();
+	CancelHandlers.Empty();
+	ReferencedObjects.Empty();
+}
+
+FText FBlendSpaceTimeSlicedExecutor::GetProgressText() const
+{
+	if (bCancelled)
+	{
+		return FText::Format(LOCTEXT("ProgressCancelled", "{0} (cancelled after {1} / {2})"), Description, NextStep, Steps.Num());
+	}
+	return FText::Format(LOCTEXT("Progress", "{0} ({1} / {2})"), Description, NextStep, Steps.Num());
+}
+
+void FBlendSpaceTimeSlicedExecutor::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObjects(ReferencedObjects);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -19,7 +19,7 @@ FString FClassifiedAnimation::GetDisplayName() const
 	return TEXT("Invalid");
 }
 
-FClassifiedAnimation* FLocomotionRoleCandidates::GetRecommended(bool bPreferRootMotion)
+const FClassifiedAnimation* FLocomotionRoleCandidates::GetRecommended(bool bPreferRootMotion) const
 {
 	if (Candidates.Num() == 0)
 	{
@@ -28,7 +28,7 @@ FClassifiedAnimation* FLocomotionRoleCandidates::GetRecommended(bool bPreferRoot
 
 	if (bPreferRootMotion)
 	{
-		for (FClassifiedAnimation& Candidate : Candidates)
+		for (const FClassifiedAnimation& Candidate : Candidates)
 		{
 			if (Candidate.bHasRootMotion)
 			{
@@ -39,8 +39,8 @@ FClassifiedAnimation* FLocomotionRoleCandidates::GetRecommended(bool bPreferRoot
 
 	// Return highest priority, prefer shorter names when priority is equal
 	// (e.g., "Idle" should be preferred over "Idle01")
-	FClassifiedAnimation* Best = &Candidates[0];
-	for (FClassifiedAnimation& Candidate : Candidates)
+	const FClassifiedAnimation* Best = &Candidates[0];
+	for (const FClassifiedAnimation& Candidate : Candidates)
 	{
 		if (Candidate.MatchPriority > Best->MatchPriority)
 		{
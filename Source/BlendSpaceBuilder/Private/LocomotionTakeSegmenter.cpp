@@ -0,0 +1,446 @@
+#include "LocomotionTakeSegmenter.h"
+#include "BlendSpaceAnalysisInternal.h"
+
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogLocomotionSegmenter, Log, All);
+
+//=============================================================================
+// Internal helpers
+//=============================================================================
+
+namespace LocomotionTakeSegmenterInternal
+{
+	// Character motion at one evaluated frame
+	struct FFrameSample
+	{
+		/** X=Right, Y=Forward (cm/s) */
+		FVector2D Velocity = FVector2D::ZeroVector;
+		double Speed = 0.0;
+
+		/** Unit travel direction, zero while idle */
+		FVector2D Direction = FVector2D::ZeroVector;
+
+		/** Absolute root yaw rate (deg/s) */
+		double YawRate = 0.0;
+
+		/** False inside a contact gap too long to interpolate (velocity is held, not measured) */
+		bool bMeasured = true;
+	};
+
+	// Statistics of the samples inside the sliding window
+	struct FWindowStats
+	{
+		FVector2D MeanVelocity = FVector2D::ZeroVector;
+		double MeanSpeed = 0.0;
+
+		/** Speed standard deviation / mean speed */
+		double SpeedVariation = 0.0;
+
+		/** Circular standard deviation of the travel direction (degrees) */
+		double DirectionDeviation = 0.0;
+
+		double MeanYawRate = 0.0;
+
+		/** Every sample of the window has a measured or interpolated velocity */
+		bool bFullyMeasured = true;
+	};
+
+	// Fixed-capacity ring buffer of frame samples with running sums.
+	// Evicted samples are subtracted from the sums, so stats are O(1) per frame.
+	class FSampleWindow
+	{
+	public:
+		explicit FSampleWindow(int32 InCapacity)
+			: Capacity(FMath::Max(1, InCapacity))
+		{
+			Samples.SetNum(Capacity);
+		}
+
+		void Push(const FFrameSample& Sample)
+		{
+			if (Num == Capacity)
+			{
+				Accumulate(Samples[Head], -1.0);
+			}
+			else
+			{
+				++Num;
+			}
+
+			Samples[Head] = Sample;
+			Accumulate(Sample, 1.0);
+			Head = (Head + 1) % Capacity;
+		}
+
+		bool IsFull() const
+		{
+			return Num == Capacity;
+		}
+
+		FWindowStats GetStats() const
+		{
+			FWindowStats Stats;
+			if (Num == 0)
+			{
+				return Stats;
+			}
+
+			Stats.MeanVelocity = SumVelocity / Num;
+			Stats.MeanSpeed = SumSpeed / Num;
+			Stats.MeanYawRate = SumYawRate / Num;
+			Stats.bFullyMeasured = NumUnmeasured < 0.5;
+
+			const double SpeedVariance = FMath::Max(0.0, SumSpeedSquared / Num - Stats.MeanSpeed * Stats.MeanSpeed);
+			Stats.SpeedVariation = Stats.MeanSpeed > UE_DOUBLE_KINDA_SMALL_NUMBER
+				? FMath::Sqrt(SpeedVariance) / Stats.MeanSpeed
+				: 0.0;
+
+			// Mean resultant length R of the unit directions; circular std = sqrt(-2 ln R)
+			if (NumMoving > 0.5)
+			{
+				const double Resultant = FMath::Clamp(SumDirection.Size() / NumMoving, UE_DOUBLE_KINDA_SMALL_NUMBER, 1.0);
+				Stats.DirectionDeviation = FMath::RadiansToDegrees(FMath::Sqrt(-2.0 * FMath::Loge(Resultant)));
+			}
+			return Stats;
+		}
+
+	private:
+		void Accumulate(const FFrameSample& Sample, double Sign)
+		{
+			SumVelocity += Sample.Velocity * Sign;
+			SumSpeed += Sample.Speed * Sign;
+			SumSpeedSquared += Sample.Speed * Sample.Speed * Sign;
+			SumDirection += Sample.Direction * Sign;
+			SumYawRate += Sample.YawRate * Sign;
+			if (!Sample.Direction.IsNearlyZero())
+			{
+				NumMoving += Sign;
+			}
+			if (!Sample.bMeasured)
+			{
+				NumUnmeasured += Sign;
+			}
+		}
+
+		TArray<FFrameSample> Samples;
+		int32 Capacity = 1;
+		int32 Head = 0;
+		int32 Num = 0;
+
+		FVector2D SumVelocity = FVector2D::ZeroVector;
+		double SumSpeed = 0.0;
+		double SumSpeedSquared = 0.0;
+		FVector2D SumDirection = FVector2D::ZeroVector;
+		double NumMoving = 0.0;
+		double NumUnmeasured = 0.0;
+		double SumYawRate = 0.0;
+	};
+
+	// Segment being extended by consecutive windows of the same role
+	struct FOpenSegment
+	{
+		bool bOpen = false;
+		ELocomotionRole Role = ELocomotionRole::Idle;
+		double StartTime = 0.0;
+		double EndTime = 0.0;
+		FVector2D SumVelocity = FVector2D::ZeroVector;
+		double SumSpeed = 0.0;
+		int32 NumWindows = 0;
+	};
+
+	// Planted-foot tracker for in-place takes (same contact test as the locomotion analysis)
+	struct FFootState
+	{
+		double GroundHeight = 0.0;
+		FVector PrevPosition = FVector::ZeroVector;
+		bool bHasPrev = false;
+	};
+}
+
+//=============================================================================
+// FLocomotionTakeSegmenter Implementation
+//=============================================================================
+
+TArray<FLocomotionTakeSegment> FLocomotionTakeSegmenter::SegmentTake(
+	const UAnimSequence* Take,
+	const FLocomotionSegmenterConfig& Config)
+{
+	using namespace LocomotionTakeSegmenterInternal;
+
+	TArray<FLocomotionTakeSegment> Segments;
+	if (!Take || !Take->GetSkeleton())
+	{
+		return Segments;
+	}
+
+	const double PlayLength = Take->GetPlayLength();
+	const double SampleInterval = 1.0 / FMath::Max(1.f, Config.SampleRate);
+	const int32 NumFrames = FMath::FloorToInt32(PlayLength / SampleInterval);
+	const int32 WindowFrames = FMath::Max(2, FMath::RoundToInt32(Config.WindowSeconds / SampleInterval));
+	const int32 HopFrames = FMath::Max(1, FMath::RoundToInt32(Config.HopSeconds / SampleInterval));
+	if (NumFrames < WindowFrames)
+	{
+		UE_LOG(LogLocomotionSegmenter, Warning, TEXT("'%s' is shorter than one analysis window (%.2fs)"),
+			*Take->GetName(), Config.WindowSeconds);
+		return Segments;
+	}
+
+	const UBlendSpaceBuilderSettings* Settings = UBlendSpaceBuilderSettings::Get();
+	const FReferenceSkeleton& RefSkeleton = Take->GetSkeleton()->GetReferenceSkeleton();
+
+	// Resolve feet for in-place takes (root motion is used whenever the root moves)
+	const FName LeftFoot = Config.LeftFootBone.IsNone() ? Settings->FindLeftFootBone(Take->GetSkeleton()) : Config.LeftFootBone;
+	const FName RightFoot = Config.RightFootBone.IsNone() ? Settings->FindRightFootBone(Take->GetSkeleton()) : Config.RightFootBone;
+	TArray<int32> FootIndices;
+	for (FName Foot : {LeftFoot, RightFoot})
+	{
+		const int32 BoneIndex = RefSkeleton.FindBoneIndex(Foot);
+		if (BoneIndex != INDEX_NONE)
+		{
+			FootIndices.AddUnique(BoneIndex);
+		}
+	}
+
+	TOptional<BlendSpaceAnalysisInternal::FContactBoneSampler> FootSampler;
+	TArray<FFootState> FootStates;
+	if (FootIndices.Num() > 0)
+	{
+		FootSampler.Emplace(Take, FootIndices);
+		for (int32 BoneIndex : FootIndices)
+		{
+			FFootState& State = FootStates.AddDefaulted_GetRef();
+			State.GroundHeight = BlendSpaceAnalysisInternal::GetRefPoseComponentSpaceTransform(RefSkeleton, BoneIndex).GetTranslation().Z;
+		}
+	}
+
+	FSampleWindow Window(WindowFrames);
+	FOpenSegment Open;
+	double LastEmittedEnd = 0.0;
+	TArray<FVector> FootPositions;
+
+	auto CloseSegment = [&]()
+	{
+		if (Open.bOpen && Open.EndTime - Open.StartTime >= Config.MinSegmentSeconds)
+		{
+			FLocomotionTakeSegment& Segment = Segments.AddDefaulted_GetRef();
+			Segment.Role = Open.Role;
+			Segment.StartTime = Open.StartTime;
+			Segment.EndTime = Open.EndTime;
+			Segment.AverageVelocity = Open.SumVelocity / Open.NumWindows;
+			Segment.AverageSpeed = float(Open.SumSpeed / Open.NumWindows);
+			LastEmittedEnd = Open.EndTime;
+		}
+		Open = FOpenSegment();
+	};
+
+	// Push one frame into the window and classify the window ending at it on hop frames
+	auto ProcessFrame = [&](int32 Frame, FFrameSample Sample)
+	{
+		const double Time = Frame * SampleInterval;
+		Sample.Speed = Sample.Velocity.Size();
+		Sample.Direction = Sample.Speed >= Config.IdleSpeedThreshold ? Sample.Velocity / Sample.Speed : FVector2D::ZeroVector;
+		Window.Push(Sample);
+
+		if (!Window.IsFull() || Frame % HopFrames != 0)
+		{
+			return;
+		}
+
+		// Classify the window ending at this frame
+		const FWindowStats Stats = Window.GetStats();
+		const double WindowStart = Time - WindowFrames * SampleInterval;
+
+		bool bStable = Stats.bFullyMeasured && Stats.MeanYawRate <= Config.MaxTurnRate;
+		ELocomotionRole Role = ELocomotionRole::Idle;
+		if (bStable && Stats.MeanSpeed >= Config.IdleSpeedThreshold)
+		{
+			bStable = Stats.DirectionDeviation <= Config.MaxDirectionDeviation
+				&& Stats.SpeedVariation <= Config.MaxSpeedVariation;
+			Role = ClassifyVelocity(Stats.MeanVelocity, Config.IdleSpeedThreshold);
+		}
+
+		if (!bStable)
+		{
+			CloseSegment();
+			return;
+		}
+
+		if (!Open.bOpen || Open.Role != Role)
+		{
+			CloseSegment();
+			Open.bOpen = true;
+			Open.Role = Role;
+			Open.StartTime = FMath::Max(WindowStart, LastEmittedEnd);
+		}
+		Open.EndTime = Time;
+		Open.SumVelocity += Stats.MeanVelocity;
+		Open.SumSpeed += Stats.MeanSpeed;
+		++Open.NumWindows;
+	};
+
+	// In-place frames without a planted foot (flight phases of a run) are held back until the next measured
+	// frame, then take velocities interpolated between the surrounding contacts; zero velocity in the air
+	// would read as speed variation and reject every run segment. At most one window of frames is held.
+	TArray<TPair<int32, FFrameSample>> FlightFrames;
+	FlightFrames.Reserve(WindowFrames);
+	TOptional<FVector2D> LastMeasuredVelocity;
+	bool bUnmeasuredGap = false;
+	auto FlushFlightFrames = [&](const TOptional<FVector2D>& NextMeasuredVelocity)
+	{
+		const int32 NumFlightFrames = FlightFrames.Num();
+		for (int32 i = 0; i < NumFlightFrames; ++i)
+		{
+			FFrameSample& Sample = FlightFrames[i].Value;
+			if (LastMeasuredVelocity.IsSet() && NextMeasuredVelocity.IsSet())
+			{
+				Sample.Velocity = FMath::Lerp(*LastMeasuredVelocity, *NextMeasuredVelocity, double(i + 1) / double(NumFlightFrames + 1));
+			}
+			else
+			{
+				// Before the first or after the last contact the nearest measured velocity is held
+				Sample.Velocity = NextMeasuredVelocity.Get(LastMeasuredVelocity.Get(FVector2D::ZeroVector));
+			}
+			ProcessFrame(FlightFrames[i].Key, Sample);
+		}
+		FlightFrames.Reset();
+	};
+
+	// A gap longer than a window is no flight phase (feet mis-detected, or the reference pose ground height does not
+	// match the take): its frames hold the last measured velocity and no window containing them forms a segment
+	auto ProcessUnmeasuredFrame = [&](int32 Frame, FFrameSample Sample)
+	{
+		Sample.Velocity = LastMeasuredVelocity.Get(FVector2D::ZeroVector);
+		Sample.bMeasured = false;
+		ProcessFrame(Frame, Sample);
+	};
+
+	for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+	{
+		const double Time = Frame * SampleInterval;
+		FFrameSample Sample;
+
+		// Root motion over the last frame interval
+		const FTransform RootDelta = Take->ExtractRootMotionFromRange(Time - SampleInterval, Time, FAnimExtractContext());
+		const FVector RootVelocity = RootDelta.GetTranslation() / SampleInterval * Take->RateScale;
+		Sample.YawRate = FMath::Abs(RootDelta.Rotator().Yaw) / SampleInterval * Take->RateScale;
+		FVector2D Velocity(RootVelocity.X, RootVelocity.Y);
+		bool bFlight = false;
+
+		// In-place: planted foot moves opposite to the character
+		if (FootSampler.IsSet())
+		{
+			FootSampler->Sample(Time, FootPositions);
+
+			double LowestPlanted = DBL_MAX;
+			FVector2D FootVelocity = FVector2D::ZeroVector;
+			for (int32 i = 0; i < FootStates.Num(); ++i)
+			{
+				FFootState& State = FootStates[i];
+				const FVector& Position = FootPositions[i];
+				if (State.bHasPrev)
+				{
+					const FVector Delta = (Position - State.PrevPosition) / SampleInterval;
+					const bool bNearGround = Position.Z <= State.GroundHeight + Settings->FootContactHeightTolerance
+						&& State.PrevPosition.Z <= State.GroundHeight + Settings->FootContactHeightTolerance;
+					const bool bVerticallyStill = FMath::Abs(Delta.Z) <= Settings->FootContactMaxVerticalSpeed;
+					if (bNearGround && bVerticallyStill && Position.Z < LowestPlanted)
+					{
+						LowestPlanted = Position.Z;
+						FootVelocity = -FVector2D(Delta.X, Delta.Y) * Take->RateScale;
+					}
+				}
+				State.PrevPosition = Position;
+				State.bHasPrev = true;
+			}
+
+			if (Velocity.Size() < Settings->MinVelocityThreshold)
+			{
+				Velocity = FootVelocity;
+				bFlight = LowestPlanted == DBL_MAX;
+			}
+		}
+
+		if (bFlight)
+		{
+			if (!bUnmeasuredGap && FlightFrames.Num() < WindowFrames)
+			{
+				FlightFrames.Emplace(Frame, Sample);
+				continue;
+			}
+
+			if (!bUnmeasuredGap)
+			{
+				bUnmeasuredGap = true;
+				CloseSegment();
+				for (const TPair<int32, FFrameSample>& FlightFrame : FlightFrames)
+				{
+					ProcessUnmeasuredFrame(FlightFrame.Key, FlightFrame.Value);
+				}
+				FlightFrames.Reset();
+			}
+			ProcessUnmeasuredFrame(Frame, Sample);
+			continue;
+		}
+
+		bUnmeasuredGap = false;
+		FlushFlightFrames(Velocity);
+		LastMeasuredVelocity = Velocity;
+		Sample.Velocity = Velocity;
+		ProcessFrame(Frame, Sample);
+	}
+	FlushFlightFrames(NullOpt);
+	CloseSegment();
+
+	UE_LOG(LogLocomotionSegmenter, Log, TEXT("'%s': %d segments over %.1fs (%d frames, window %d frames)"),
+		*Take->GetName(), Segments.Num(), PlayLength, NumFrames, WindowFrames);
+	for (const FLocomotionTakeSegment& Segment : Segments)
+	{
+		UE_LOG(LogLocomotionSegmenter, Log, TEXT("  %-18s %8.2fs - %8.2fs  Velocity(%.1f, %.1f)  Speed %.1f"),
+			*UBlendSpaceBuilderSettings::GetRoleDisplayName(Segment.Role), Segment.StartTime, Segment.EndTime,
+			Segment.AverageVelocity.X, Segment.AverageVelocity.Y, Segment.AverageSpeed);
+	}
+	return Segments;
+}
+
+ELocomotionRole FLocomotionTakeSegmenter::ClassifyVelocity(const FVector2D& Velocity, float IdleSpeedThreshold)
+{
+	const float Speed = Velocity.Size();
+	if (Speed < IdleSpeedThreshold)
+	{
+		return ELocomotionRole::Idle;
+	}
+
+	// Tier boundaries halfway between the configured tier speeds
+	const UBlendSpaceBuilderSettings* Settings = UBlendSpaceBuilderSettings::Get();
+	const float WalkSpeed = Settings->GetSpeedForTier(TEXT("Walk"));
+	const float RunSpeed = Settings->GetSpeedForTier(TEXT("Run"));
+	const float SprintSpeed = Settings->GetSpeedForTier(TEXT("Sprint"));
+	const bool bWalk = Speed < 0.5f * (WalkSpeed + RunSpeed);
+	const bool bSprint = Speed >= 0.5f * (RunSpeed + SprintSpeed);
+
+	// Direction sector (0=Right, 90=Forward), 45 degrees each
+	float AngleDegrees = FMath::RadiansToDegrees(FMath::Atan2(Velocity.Y, Velocity.X));
+	if (AngleDegrees < 0.f)
+	{
+		AngleDegrees += 360.f;
+	}
+	const int32 Sector = FMath::RoundToInt32(AngleDegrees / 45.f) % 8;
+
+	// Only forward has a sprint role
+	if (bSprint && Sector == 2)
+	{
+		return ELocomotionRole::SprintForward;
+	}
+
+	static const ELocomotionRole WalkRoles[8] = {
+		ELocomotionRole::WalkRight, ELocomotionRole::WalkForwardRight, ELocomotionRole::WalkForward, ELocomotionRole::WalkForwardLeft,
+		ELocomotionRole::WalkLeft, ELocomotionRole::WalkBackwardLeft, ELocomotionRole::WalkBackward, ELocomotionRole::WalkBackwardRight
+	};
+	static const ELocomotionRole RunRoles[8] = {
+		ELocomotionRole::RunRight, ELocomotionRole::RunForwardRight, ELocomotionRole::RunForward, ELocomotionRole::RunForwardLeft,
+		ELocomotionRole::RunLeft, ELocomotionRole::RunBackwardLeft, ELocomotionRole::RunBackward, ELocomotionRole::RunBackwardRight
+	};
+	return bWalk ? WalkRoles[Sector] : RunRoles[Sector];
+}
@@ -4,8 +4,11 @@
 #include "BlendSpaceBuilderSettings.h"
 #include "LocomotionAnimClassifier.h"
 #include "BlendSpaceFactory.h"
+#include "BlendSpaceAnalysisDerivedData.h"
 #include "Animation/Skeleton.h"
 #include "Animation/AnimSequence.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
 
 #include "Widgets/Input/SNumericEntryBox.h"
 #include "Widgets/Input/SEditableTextBox.h"
@@ -17,6 +20,7 @@
 #include "Widgets/Layout/SSeparator.h"
 #include "Widgets/Layout/SExpandableArea.h"
 #include "Widgets/Layout/SWidgetSwitcher.h"
+#include "Widgets/Notifications/SProgressBar.h"
 
 #define LOCTEXT_NAMESPACE "SBlendSpaceConfigDialog"
 
@@ -43,10 +47,9 @@ void SBlendSpaceConfigDialog::Construct(const FArguments& InArgs)
 	if (Classifier)
 	{
 		bool bPreferRootMotion = Settings->bPreferRootMotionAnimations;
-		for (auto& Pair : Classifier->GetClassifiedResults())
+		for (const auto& Pair : Classifier->GetClassifiedResults())
 		{
-			FLocomotionRoleCandidates& Candidates = const_cast<FLocomotionRoleCandidates&>(Pair.Value);
-			if (FClassifiedAnimation* Recommended = Candidates.GetRecommended(bPreferRootMotion))
+			if (const FClassifiedAnimation* Recommended = Pair.Value.GetRecommended(bPreferRootMotion))
 			{
 				SelectedAnimations.Add(Pair.Key, Recommended->Animation.Get());
 			}
@@ -62,6 +65,9 @@ void SBlendSpaceConfigDialog::Construct(const FArguments& InArgs)
 		// Initialize custom foot bones with detected values
 		CustomLeftFootBone = DetectedLeftFootBone;
 		CustomRightFootBone = DetectedRightFootBone;
+
+		// Skeletons imported at another unit scale are normalized from their leg length
+		ScaleDivisor = FBlendSpaceFactory::GetAutoScaleDivisor(Skeleton);
 	}
 
 	ChildSlot
@@ -149,6 +155,26 @@ void SBlendSpaceConfigDialog::Construct(const FArguments& InArgs)
 			BuildButtonSection()
 		]
 	];
+
+	// Analyze the likely clips while the user reviews the selection
+	StartPrefetch();
+}
+
+SBlendSpaceConfigDialog::~SBlendSpaceConfigDialog()
+{
+	// Tasks read the animations this dialog keeps referenced, so they must finish before it goes away
+	TArray<UE::Tasks::FTask> Tasks;
+	for (auto& Pair : InFlightAnalyses)
+	{
+		Pair.Value.Progress->Cancel();
+		Tasks.Add(Pair.Value.Task);
+	}
+	if (PrefetchAnalysis.Progress)
+	{
+		PrefetchAnalysis.Progress->Cancel();
+		Tasks.Add(PrefetchAnalysis.Task);
+	}
+	UE::Tasks::Wait(Tasks);
 }
 
 TSharedRef<SWidget> SBlendSpaceConfigDialog::BuildAnalysisSection()
@@ -187,6 +213,39 @@ TSharedRef<SWidget> SBlendSpaceConfigDialog::BuildAnalysisSection()
 					+ SSegmentedControl<EBlendSpaceAnalysisType>::Slot(EBlendSpaceAnalysisType::LocomotionStride)
 					.Text(LOCTEXT("LocomotionStride", "Loco (Stride)"))
 					.ToolTip(LOCTEXT("LocomotionStrideTip", "Stride length / play time"))
+					+ SSegmentedControl<EBlendSpaceAnalysisType>::Slot(EBlendSpaceAnalysisType::Auto)
+					.Text(LOCTEXT("AnalysisAuto", "Auto"))
+					.ToolTip(LOCTEXT("AnalysisAutoTip", "Root motion for clips that move their root, foot analysis for in-place clips"))
+				]
+			]
+			// Analysis Quality Selection
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(4)
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.FillWidth(0.3f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("AnalysisQuality", "Analysis Quality:"))
+				]
+				+ SHorizontalBox::Slot()
+				.FillWidth(0.7f)
+				[
+					SNew(SSegmentedControl<EBlendSpaceAnalysisQuality>)
+					.Value_Lambda([this]() { return SelectedAnalysisQuality; })
+					.OnValueChanged(this, &SBlendSpaceConfigDialog::OnAnalysisQualityChanged)
+					+ SSegmentedControl<EBlendSpaceAnalysisQuality>::Slot(EBlendSpaceAnalysisQuality::Fast)
+					.Text(LOCTEXT("QualityFast", "Fast"))
+					.ToolTip(LOCTEXT("QualityFastTip", "Sample foot bones at ~10 Hz, then refine in the background"))
+					+ SSegmentedControl<EBlendSpaceAnalysisQuality>::Slot(EBlendSpaceAnalysisQuality::Balanced)
+					.Text(LOCTEXT("QualityBalanced", "Balanced"))
+					.ToolTip(LOCTEXT("QualityBalancedTip", "Sample foot bones at ~30 Hz, then refine in the background"))
+					+ SSegmentedControl<EBlendSpaceAnalysisQuality>::Slot(EBlendSpaceAnalysisQuality::Exact)
+					.Text(LOCTEXT("QualityExact", "Exact"))
+					.ToolTip(LOCTEXT("QualityExactTip", "Evaluate every key"))
 				]
 			]
 			// Foot Bone Info (only shown when Locomotion is selected)
@@ -271,6 +330,53 @@ TSharedRef<SWidget> SBlendSpaceConfigDialog::BuildAnalysisSection()
 					})
 				]
 			]
+			// Custom contact bones (comma separated, for creatures with more than two feet)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(4)
+			[
+				SNew(SHorizontalBox)
+				.Visibility_Lambda([this]() {
+					return (bUseCustomFootBones && GetFootBoneVisibility() == EVisibility::Visible)
+						? EVisibility::Visible : EVisibility::Collapsed;
+				})
+				+ SHorizontalBox::Slot()
+				.FillWidth(0.3f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("ContactBonesLabel", "Contact Bones:"))
+				]
+				+ SHorizontalBox::Slot()
+				.FillWidth(0.7f)
+				.Padding(4, 0)
+				[
+					SNew(SEditableTextBox)
+					.HintText(LOCTEXT("ContactBonesHint", "e.g. hoof_fl, hoof_fr, hoof_bl, hoof_br"))
+					.ToolTipText(LOCTEXT("ContactBonesTip", "Comma separated contact bones; overrides Left/Right when set"))
+					.Text_Lambda([this]() {
+						TArray<FString> Names;
+						for (FName Bone : CustomContactBones)
+						{
+							Names.Add(Bone.ToString());
+						}
+						return FText::FromString(FString::Join(Names, TEXT(", ")));
+					})
+					.OnTextCommitted_Lambda([this](const FText& Text, ETextCommit::Type) {
+						TArray<FString> Names;
+						Text.ToString().ParseIntoArray(Names, TEXT(","));
+						CustomContactBones.Reset();
+						for (const FString& Name : Names)
+						{
+							const FString Trimmed = Name.TrimStartAndEnd();
+							if (!Trimmed.IsEmpty())
+							{
+								CustomContactBones.AddUnique(FName(*Trimmed));
+							}
+						}
+					})
+				]
+			]
 			// Stride Multiplier (only shown when Stride is selected)
 			+ SVerticalBox::Slot()
 			.AutoHeight()
@@ -326,7 +432,20 @@ TSharedRef<SWidget> SBlendSpaceConfigDialog::BuildAnalysisSection()
 					.Delta(0.1f)
 					.Value_Lambda([this]() { return ScaleDivisor; })
 					.OnValueChanged_Lambda([this](float NewValue) { ScaleDivisor = FMath::Max(0.001f, NewValue); })
-					.ToolTipText(LOCTEXT("ScaleDivisorTip", "Divide analysis results by this value to normalize skeleton scale (default: 1.0)"))
+					.ToolTipText(LOCTEXT("ScaleDivisorTip", "Divide analysis results by this value to normalize skeleton scale (derived from the reference pose leg length)"))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(4, 0, 0, 0)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("AutoScaleDivisor", "Auto"))
+					.ToolTipText(LOCTEXT("AutoScaleDivisorTip", "Derive the scale divisor from the skeleton's hip-to-foot length"))
+					.OnClicked_Lambda([this]()
+					{
+						ScaleDivisor = FBlendSpaceFactory::GetAutoScaleDivisor(Skeleton);
+						return FReply::Handled();
+					})
 				]
 			]
 			// Analyze Button
@@ -346,6 +465,53 @@ TSharedRef<SWidget> SBlendSpaceConfigDialog::BuildAnalysisSection()
 					.IsEnabled_Lambda([this]() { return HasSelectedAnimations(); })
 					.ToolTipText(LOCTEXT("AnalyzeTip", "Calculate sample positions based on selected analysis type"))
 				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(4, 0, 0, 0)
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("ForceReanalyze", "Force Re-analyze"))
+					.OnClicked(this, &SBlendSpaceConfigDialog::OnForceReanalyzeClicked)
+					.IsEnabled_Lambda([this]() { return HasSelectedAnimations(); })
+					.ToolTipText(LOCTEXT("ForceReanalyzeTip", "Analyze every selected clip again without any analysis cache and replace the cached results"))
+				]
+			]
+			// Analysis progress
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(4, 0, 4, 8)
+			[
+				SNew(SHorizontalBox)
+				.Visibility_Lambda([this]() { return bAnalysisInProgress ? EVisibility::Visible : EVisibility::Collapsed; })
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.0f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(SProgressBar)
+					.Percent_Lambda([this]() -> TOptional<float>
+					{
+						return NumSamplesToAnalyze > 0 ? float(NumSamplesAnalyzed) / float(NumSamplesToAnalyze) : 0.f;
+					})
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				.Padding(8, 0)
+				[
+					SNew(STextBlock)
+					.Text_Lambda([this]()
+					{
+						return FText::Format(LOCTEXT("AnalysisProgress", "{0} / {1}"), NumSamplesAnalyzed, NumSamplesToAnalyze);
+					})
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("CancelAnalysis", "Cancel"))
+					.ToolTipText(LOCTEXT("CancelAnalysisTip", "Stop analyzing the remaining samples and keep the results so far"))
+					.OnClicked(this, &SBlendSpaceConfigDialog::OnCancelAnalysisClicked)
+				]
 			]
 		];
 }
@@ -375,6 +541,16 @@ TSharedRef<SWidget> SBlendSpaceConfigDialog::BuildAnalysisResultsSection()
 				.Text(this, &SBlendSpaceConfigDialog::GetAnalysisResultsText)
 				.AutoWrapText(true)
 			]
+			// Background refinement status
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(4, 0)
+			[
+				SNew(STextBlock)
+				.Visibility_Lambda([this]() { return bRefinementInProgress ? EVisibility::Visible : EVisibility::Collapsed; })
+				.Text(LOCTEXT("RefiningResults", "Refining coarse results in the background..."))
+				.ColorAndOpacity(FSlateColor(FLinearColor(0.5f, 0.5f, 0.5f)))
+			]
 			// Calculated axis range
 			+ SVerticalBox::Slot()
 			.AutoHeight()
@@ -830,27 +1006,152 @@ TSharedRef<SWidget> SBlendSpaceConfigDialog::BuildButtonSection()
 
 FReply SBlendSpaceConfigDialog::OnAnalyzeClicked()
 {
-	// Determine which foot bones to use
-	FName LeftBoneToUse = bUseCustomFootBones ? CustomLeftFootBone : DetectedLeftFootBone;
-	FName RightBoneToUse = bUseCustomFootBones ? CustomRightFootBone : DetectedRightFootBone;
-
-	// Run analysis
-	AnalyzedPositions = FBlendSpaceFactory::AnalyzeSamplePositions(
-		SelectedAnimations,
-		SelectedAnalysisType,
-		LeftBoneToUse,
-		RightBoneToUse,
-		StrideMultiplier);
+	StartAnalysis(false);
+	return FReply::Handled();
+}
 
-	// Apply scale divisor to normalize skeleton scale
-	if (ScaleDivisor > KINDA_SMALL_NUMBER && ScaleDivisor != 1.0f)
+FReply SBlendSpaceConfigDialog::OnForceReanalyzeClicked()
+{
+	StartAnalysis(true);
+	return FReply::Handled();
+}
+
+void SBlendSpaceConfigDialog::StartAnalysis(bool bBypassCache)
+{
+	CancelAnalysisTasks();
+
+	// Prefetched samples are picked up from the cache; the rest no longer wait behind the prefetch
+	CancelPrefetch();
+
+	// The dialog's own results do not notice clips edited since; the analysis caches key on the clip's content,
+	// so unchanged clips are still served from them unless the cache is bypassed
+	ResultHistory.Reset();
+
+	// Run analysis at the selected quality in the background for the clips without a result yet;
+	// results appear as each sample finishes and coarse ones are refined once every sample is in
+	bAnalysisPerformed = true;
+	bUseAnalyzedPositions = true;
+	TGuardValue<bool> BypassCacheGuard(bBypassAnalysisCache, bBypassCache);
+	SyncAnalysisWithSelection();
+}
+
+FBlendSpaceAnalysisOptions SBlendSpaceConfigDialog::MakeAnalysisOptions() const
+{
+	FBlendSpaceAnalysisOptions Options;
+	Options.AnalysisType = SelectedAnalysisType;
+	Options.Quality = SelectedAnalysisQuality;
+	Options.LeftFootBone = bUseCustomFootBones ? CustomLeftFootBone : DetectedLeftFootBone;
+	Options.RightFootBone = bUseCustomFootBones ? CustomRightFootBone : DetectedRightFootBone;
+	if (bUseCustomFootBones)
 	{
-		for (auto& Pair : AnalyzedPositions)
+		Options.ContactBones = CustomContactBones;
+	}
+	Options.StrideMultiplier = StrideMultiplier;
+	Options.bBypassCache = bBypassAnalysisCache;
+
+	// Captured here on the game thread so the background refinement never reads the settings object
+	Options.SettingsSnapshot = FBlendSpaceAnalysisSettings::Capture();
+	return Options;
+}
+
+uint32 SBlendSpaceConfigDialog::GetAnalysisSettingsKey() const
+{
+	// Everything that changes a sample's result; quality only refines it
+	uint32 Key = GetTypeHash(SelectedAnalysisType);
+	Key = HashCombine(Key, GetTypeHash(bUseCustomFootBones ? CustomLeftFootBone : DetectedLeftFootBone));
+	Key = HashCombine(Key, GetTypeHash(bUseCustomFootBones ? CustomRightFootBone : DetectedRightFootBone));
+	if (bUseCustomFootBones)
+	{
+		for (FName Bone : CustomContactBones)
 		{
-			Pair.Value /= ScaleDivisor;
+			Key = HashCombine(Key, GetTypeHash(Bone));
 		}
 	}
+	Key = HashCombine(Key, GetTypeHash(StrideMultiplier));
+	Key = HashCombine(Key, GetTypeHash(ScaleDivisor));
+	return Key;
+}
 
+void SBlendSpaceConfigDialog::ApplySampleResult(UAnimSequence* Animation, const FBlendSpaceAnalysisResult& Result)
+{
+	// The position follows the role the clip is selected for
+	for (const auto& Pair : SelectedAnimations)
+	{
+		if (Pair.Value == Animation)
+		{
+			FBlendSpaceAnalysisResult RoleResult = Result;
+			RoleResult.Position = FBlendSpaceFactory::GetRolePositionFromVelocity(Pair.Key, Result.Velocity);
+			AnalysisResults.Add(Animation, RoleResult);
+			AnalyzedPositions.Add(Animation, RoleResult.Position);
+		}
+	}
+}
+
+void SBlendSpaceConfigDialog::SyncAnalysisWithSelection()
+{
+	const uint32 SettingsKey = GetAnalysisSettingsKey();
+
+	// Clips already being analyzed or refined with the current settings are not launched again
+	TSet<UAnimSequence*> PendingAnalysis;
+	TSet<UAnimSequence*> PendingRefinement;
+	for (const auto& Pair : InFlightAnalyses)
+	{
+		if (Pair.Value.Generation == AnalysisGeneration && !Pair.Value.Progress->IsCancelled())
+		{
+			(Pair.Value.bRefinement ? PendingRefinement : PendingAnalysis).Append(Pair.Value.Animations);
+		}
+	}
+
+	// Rebuild the results of the selection from earlier results; only the rest is analyzed
+	AnalysisResults.Reset();
+	AnalyzedPositions.Reset();
+	TMap<ELocomotionRole, UAnimSequence*> MissingAnimations;
+	TArray<UAnimSequence*> ReusedAnimations;
+	for (const auto& Pair : SelectedAnimations)
+	{
+		if (!Pair.Value)
+		{
+			continue;
+		}
+
+		if (const FBlendSpaceAnalysisResult* Previous = ResultHistory.Find(MakeTuple(FObjectKey(Pair.Value), SettingsKey)))
+		{
+			ApplySampleResult(Pair.Value, *Previous);
+			if (!PendingRefinement.Contains(Pair.Value))
+			{
+				ReusedAnimations.Add(Pair.Value);
+			}
+		}
+		else if (!PendingAnalysis.Contains(Pair.Value))
+		{
+			MissingAnimations.Add(Pair.Key, Pair.Value);
+		}
+	}
+
+	UpdateAnalyzedSpeeds();
+	if (AnalyzedPositions.Num() > 0)
+	{
+		RecalculateAxisRange();
+	}
+
+	// Coarse results whose refinement was interrupted
+	StartBackgroundRefinement(ReusedAnimations, bBypassAnalysisCache);
+
+	if (MissingAnimations.Num() > 0)
+	{
+		if (!bAnalysisInProgress)
+		{
+			NumSamplesToAnalyze = 0;
+			NumSamplesAnalyzed = 0;
+		}
+		NumSamplesToAnalyze += MissingAnimations.Num();
+		bAnalysisInProgress = true;
+		LaunchAnalysis(MissingAnimations, MakeAnalysisOptions(), false);
+	}
+}
+
+void SBlendSpaceConfigDialog::UpdateAnalyzedSpeeds()
+{
 	// Calculate max speed and role-based speeds from analyzed positions
 	AnalyzedMaxSpeed = 0.f;
 	AnalyzedWalkSpeed = 0.f;
@@ -908,26 +1209,312 @@ FReply SBlendSpaceConfigDialog::OnAnalyzeClicked()
 			break;
 		}
 	}
+}
 
-	// Calculate axis range with grid settings
-	FBlendSpaceFactory::CalculateAxisRangeFromAnalysis(
-		AnalyzedPositions,
-		GridDivisions,
-		bUseNiceNumbers,
-		AnalyzedXMin, AnalyzedXMax, AnalyzedYMin, AnalyzedYMax);
+void SBlendSpaceConfigDialog::StartBackgroundRefinement(const TArray<UAnimSequence*>& Animations, bool bBypassCache)
+{
+	// Only refine coarse results whose error estimate is outside tolerance
+	const float Tolerance = UBlendSpaceBuilderSettings::Get()->AnalysisErrorTolerance;
 
-	// Update axis fields with analyzed range
-	XAxisMin = AnalyzedXMin;
-	XAxisMax = AnalyzedXMax;
-	YAxisMin = AnalyzedYMin;
-	YAxisMax = AnalyzedYMax;
+	TMap<ELocomotionRole, UAnimSequence*> AnimationsToRefine;
+	for (const auto& Pair : SelectedAnimations)
+	{
+		const FBlendSpaceAnalysisResult* Result = Animations.Contains(Pair.Value) ? AnalysisResults.Find(Pair.Value) : nullptr;
+		if (Result && !Result->IsWithinTolerance(Tolerance))
+		{
+			AnimationsToRefine.Add(Pair.Key, Pair.Value);
+		}
+	}
 
-	bAnalysisPerformed = true;
-	bUseAnalyzedPositions = true;
+	if (AnimationsToRefine.Num() == 0)
+	{
+		return;
+	}
+
+	// A forced re-analysis refines without the caches too, or the cached Exact result would come straight back
+	FBlendSpaceAnalysisOptions Options = MakeAnalysisOptions();
+	Options.Quality = EBlendSpaceAnalysisQuality::Exact;
+	Options.bBypassCache = bBypassCache;
+
+	bRefinementInProgress = true;
+	LaunchAnalysis(AnimationsToRefine, Options, true);
+}
+
+void SBlendSpaceConfigDialog::LaunchAnalysis(const TMap<ELocomotionRole, UAnimSequence*>& Animations, const FBlendSpaceAnalysisOptions& Options, bool bRefinement)
+{
+	TWeakPtr<SBlendSpaceConfigDialog> WeakDialog = StaticCastSharedRef<SBlendSpaceConfigDialog>(AsShared());
+	const int32 TaskId = NextAnalysisTaskId++;
+	const int32 Generation = AnalysisGeneration;
+	const uint32 SettingsKey = GetAnalysisSettingsKey();
+	const float TaskScaleDivisor = ScaleDivisor;
+
+	// Each sample is shown as soon as its result is ready
+	TSharedRef<FBlendSpaceAnalysisProgress> Progress = MakeShared<FBlendSpaceAnalysisProgress>();
+	Progress->OnSampleAnalyzed = [WeakDialog, Generation, SettingsKey, TaskScaleDivisor, bRefinement](UAnimSequence* Animation, const FBlendSpaceAnalysisResult& Result)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakDialog, Animation, Result, Generation, SettingsKey, TaskScaleDivisor, bRefinement]()
+		{
+			if (TSharedPtr<SBlendSpaceConfigDialog> Dialog = WeakDialog.Pin())
+			{
+				Dialog->OnSampleAnalyzed(Animation, Result, Generation, SettingsKey, TaskScaleDivisor, bRefinement);
+			}
+		});
+	};
+
+	// Keep the animations referenced until the task has finished, even once its results are outdated
+	FInFlightAnalysis& InFlight = InFlightAnalyses.Add(TaskId);
+	InFlight.Progress = Progress;
+	InFlight.Generation = Generation;
+	InFlight.bRefinement = bRefinement;
+	InFlight.bBypassCache = Options.bBypassCache;
+	Animations.GenerateValueArray(InFlight.Animations);
+
+	InFlight.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakDialog, Animations, Options, Progress, TaskId, Generation, bRefinement]()
+	{
+		FBlendSpaceFactory::AnalyzeSamples(Animations, Options, &Progress.Get());
+
+		AsyncTask(ENamedThreads::GameThread, [WeakDialog, TaskId, Generation, bRefinement]()
+		{
+			if (TSharedPtr<SBlendSpaceConfigDialog> Dialog = WeakDialog.Pin())
+			{
+				Dialog->OnAnalysisTaskCompleted(TaskId, Generation, bRefinement);
+			}
+		});
+	}, bRefinement ? LowLevelTasks::ETaskPriority::BackgroundNormal : LowLevelTasks::ETaskPriority::Normal);
+}
+
+void SBlendSpaceConfigDialog::OnSampleAnalyzed(UAnimSequence* Animation, const FBlendSpaceAnalysisResult& Result, int32 Generation, uint32 SettingsKey, float InScaleDivisor, bool bRefinement)
+{
+	FBlendSpaceAnalysisResult ScaledResult = Result;
+
+	// Apply scale divisor to normalize skeleton scale
+	if (InScaleDivisor > KINDA_SMALL_NUMBER && InScaleDivisor != 1.0f)
+	{
+		ScaledResult.Velocity /= InScaleDivisor;
+		ScaledResult.Position /= InScaleDivisor;
+		ScaledResult.ErrorEstimate /= InScaleDivisor;
+	}
+
+	// Kept even once outdated, so selecting this clip or these settings again reuses it
+	const TPair<FObjectKey, uint32> HistoryKey(FObjectKey(Animation), SettingsKey);
+	const FBlendSpaceAnalysisResult* Previous = ResultHistory.Find(HistoryKey);
+	if (!Previous || Previous->Quality <= ScaledResult.Quality)
+	{
+		ResultHistory.Add(HistoryKey, ScaledResult);
+	}
+
+	// Analysis settings changed since this analysis started
+	if (Generation != AnalysisGeneration)
+	{
+		return;
+	}
+
+	if (!bRefinement)
+	{
+		++NumSamplesAnalyzed;
+	}
+
+	// The clip may have been deselected while it was analyzed
+	if (!SelectedAnimations.FindKey(Animation))
+	{
+		return;
+	}
+
+	ApplySampleResult(Animation, ScaledResult);
+	UpdateAnalyzedSpeeds();
+	RecalculateAxisRange();
+}
+
+void SBlendSpaceConfigDialog::OnAnalysisTaskCompleted(int32 TaskId, int32 Generation, bool bRefinement)
+{
+	FInFlightAnalysis InFlight;
+	if (!InFlightAnalyses.RemoveAndCopyValue(TaskId, InFlight) || Generation != AnalysisGeneration)
+	{
+		return;
+	}
+
+	UpdateAnalysisProgressState();
+
+	// Cancelled analyses keep their partial results without refining them
+	if (!bRefinement && !InFlight.Progress->IsCancelled())
+	{
+		StartBackgroundRefinement(InFlight.Animations, InFlight.bBypassCache);
+
+		// Continue with the alternates the Analyze click interrupted
+		StartPrefetch();
+	}
+}
+
+void SBlendSpaceConfigDialog::UpdateAnalysisProgressState()
+{
+	// Single-clip analyses launched by selection changes may overlap the initial one
+	bAnalysisInProgress = false;
+	bRefinementInProgress = false;
+	for (const auto& Pair : InFlightAnalyses)
+	{
+		if (Pair.Value.Generation == AnalysisGeneration)
+		{
+			bool& bInProgress = Pair.Value.bRefinement ? bRefinementInProgress : bAnalysisInProgress;
+			bInProgress = true;
+		}
+	}
+}
 
+FReply SBlendSpaceConfigDialog::OnCancelAnalysisClicked()
+{
+	// Samples already analyzed stay; the task finishes once its running samples are done
+	for (auto& Pair : InFlightAnalyses)
+	{
+		Pair.Value.Progress->Cancel();
+	}
 	return FReply::Handled();
 }
 
+void SBlendSpaceConfigDialog::CancelAnalysisTasks()
+{
+	++AnalysisGeneration;
+	bAnalysisInProgress = false;
+	bRefinementInProgress = false;
+	for (auto& Pair : InFlightAnalyses)
+	{
+		Pair.Value.Progress->Cancel();
+	}
+}
+
+void SBlendSpaceConfigDialog::StartPrefetch()
+{
+	const UBlendSpaceBuilderSettings* Settings = UBlendSpaceBuilderSettings::Get();
+	if (!Settings->bPrefetchAnalysis || !Classifier)
+	{
+		return;
+	}
+
+	// Selected clips first, then the next best candidates of every role, one rank per batch
+	TArray<TMap<ELocomotionRole, UAnimSequence*>> Batches;
+	Batches.Add(SelectedAnimations);
+	const bool bPreferRootMotion = Settings->bPreferRootMotionAnimations;
+	for (const auto& Pair : Classifier->GetClassifiedResults())
+	{
+		UAnimSequence* Selected = SelectedAnimations.FindRef(Pair.Key);
+		TArray<const FClassifiedAnimation*> Alternates;
+		for (const FClassifiedAnimation& Candidate : Pair.Value.Candidates)
+		{
+			if (Candidate.Animation.IsValid() && Candidate.Animation.Get() != Selected)
+			{
+				Alternates.Add(&Candidate);
+			}
+		}
+
+		// Same ranking as the recommendation: root motion (if preferred), priority, then shorter names
+		Alternates.StableSort([bPreferRootMotion](const FClassifiedAnimation& A, const FClassifiedAnimation& B)
+		{
+			if (bPreferRootMotion && A.bHasRootMotion != B.bHasRootMotion)
+			{
+				return A.bHasRootMotion;
+			}
+			if (A.MatchPriority != B.MatchPriority)
+			{
+				return A.MatchPriority > B.MatchPriority;
+			}
+			return A.Animation->GetName().Len() < B.Animation->GetName().Len();
+		});
+
+		const int32 NumAlternates = FMath::Min(Alternates.Num(), Settings->PrefetchAlternatesPerRole);
+		for (int32 Rank = 0; Rank < NumAlternates; ++Rank)
+		{
+			if (Batches.Num() <= Rank + 1)
+			{
+				Batches.AddDefaulted();
+			}
+			Batches[Rank + 1].Add(Pair.Key, Alternates[Rank]->Animation.Get());
+		}
+	}
+
+	// Same options an Analyze click would use, so its cache lookups hit. One worker keeps the
+	// prefetch from competing with analyses the user starts.
+	FBlendSpaceAnalysisOptions Options = MakeAnalysisOptions();
+	TSharedRef<FBlendSpaceAnalysisSettings> Snapshot = MakeShared<FBlendSpaceAnalysisSettings>(*Options.SettingsSnapshot);
+	Snapshot->MaxAnalysisWorkers = 1;
+	Options.SettingsSnapshot = Snapshot;
+
+	// The previous prefetch stops after its running sample; the new one starts once it has finished
+	CancelPrefetch();
+	const UE::Tasks::FTask PreviousTask = PrefetchAnalysis.Task;
+
+	TSharedRef<FBlendSpaceAnalysisProgress> Progress = MakeShared<FBlendSpaceAnalysisProgress>();
+	PrefetchAnalysis.Progress = Progress;
+	for (const TMap<ELocomotionRole, UAnimSequence*>& Batch : Batches)
+	{
+		for (const auto& Pair : Batch)
+		{
+			PrefetchAnalysis.Animations.AddUnique(Pair.Value);
+		}
+	}
+
+	TWeakPtr<SBlendSpaceConfigDialog> WeakDialog = StaticCastSharedRef<SBlendSpaceConfigDialog>(AsShared());
+	const int32 Generation = ++PrefetchGeneration;
+	auto PrefetchBody = [WeakDialog, Batches, Options, Progress, Generation]()
+	{
+		// Results only land in the analysis cache
+		for (const TMap<ELocomotionRole, UAnimSequence*>& Batch : Batches)
+		{
+			if (Progress->IsCancelled())
+			{
+				break;
+			}
+			FBlendSpaceFactory::AnalyzeSamples(Batch, Options, &Progress.Get());
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakDialog, Generation]()
+		{
+			if (TSharedPtr<SBlendSpaceConfigDialog> Dialog = WeakDialog.Pin())
+			{
+				Dialog->OnPrefetchCompleted(Generation);
+			}
+		});
+	};
+
+	PrefetchAnalysis.Task = PreviousTask.IsValid()
+		? UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(PrefetchBody), UE::Tasks::Prerequisites(PreviousTask), LowLevelTasks::ETaskPriority::BackgroundLow)
+		: UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(PrefetchBody), LowLevelTasks::ETaskPriority::BackgroundLow);
+}
+
+void SBlendSpaceConfigDialog::CancelPrefetch()
+{
+	if (PrefetchAnalysis.Progress)
+	{
+		PrefetchAnalysis.Progress->Cancel();
+	}
+}
+
+void SBlendSpaceConfigDialog::OnPrefetchCompleted(int32 Generation)
+{
+	// A newer prefetch runs after this one and still reads the animations
+	if (Generation == PrefetchGeneration)
+	{
+		PrefetchAnalysis.Animations.Empty();
+	}
+}
+
+void SBlendSpaceConfigDialog::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (auto& Pair : InFlightAnalyses)
+	{
+		Collector.AddReferencedObjects(Pair.Value.Animations);
+	}
+	Collector.AddReferencedObjects(PrefetchAnalysis.Animations);
+
+	// Reused results still name their mirror source
+	for (auto& Pair : ResultHistory)
+	{
+		Collector.AddReferencedObject(Pair.Value.MirrorSource);
+	}
+	for (auto& Pair : AnalysisResults)
+	{
+		Collector.AddReferencedObject(Pair.Value.MirrorSource);
+	}
+}
+
 FReply SBlendSpaceConfigDialog::OnResetToRoleDefaultsClicked()
 {
 	if (AnalyzedMaxSpeed <= KINDA_SMALL_NUMBER)
@@ -1009,6 +1596,9 @@ FReply SBlendSpaceConfigDialog::OnResetToRoleDefaultsClicked()
 		}
 	};
 
+	// Pending analysis would overwrite the role default positions
+	CancelAnalysisTasks();
+
 	// Reset positions based on role
 	for (const auto& Pair : SelectedAnimations)
 	{
@@ -1036,9 +1626,20 @@ FReply SBlendSpaceConfigDialog::OnResetToRoleDefaultsClicked()
 void SBlendSpaceConfigDialog::OnAnalysisTypeChanged(EBlendSpaceAnalysisType NewType)
 {
 	SelectedAnalysisType = NewType;
-	// Clear previous analysis when type changes
-	bAnalysisPerformed = false;
-	AnalyzedPositions.Empty();
+
+	// Results of the previous type stay in the history; only clips never analyzed with this type are analyzed
+	CancelAnalysisTasks();
+	if (bAnalysisPerformed)
+	{
+		SyncAnalysisWithSelection();
+	}
+	StartPrefetch();
+}
+
+void SBlendSpaceConfigDialog::OnAnalysisQualityChanged(EBlendSpaceAnalysisQuality NewQuality)
+{
+	// Existing results stay valid; the new quality applies to the next analysis
+	SelectedAnalysisQuality = NewQuality;
 }
 
 void SBlendSpaceConfigDialog::OnGridDivisionsChanged(int32 NewValue)
@@ -1117,11 +1718,10 @@ void SBlendSpaceConfigDialog::OnAnimationSelected(ELocomotionRole Role, UAnimSeq
 		SelectedAnimations.Remove(Role);
 	}
 
-	// Clear analysis when animations change
+	// Only the newly selected clip is analyzed; the other samples keep their results
 	if (bAnalysisPerformed)
 	{
-		bAnalysisPerformed = false;
-		AnalyzedPositions.Empty();
+		SyncAnalysisWithSelection();
 	}
 }
 
@@ -1142,6 +1742,10 @@ FBlendSpaceBuildConfig SBlendSpaceConfigDialog::GetBuildConfig() const
 	Config.AnalysisType = SelectedAnalysisType;
 	Config.LeftFootBoneName = bUseCustomFootBones ? CustomLeftFootBone : DetectedLeftFootBone;
 	Config.RightFootBoneName = bUseCustomFootBones ? CustomRightFootBone : DetectedRightFootBone;
+	if (bUseCustomFootBones)
+	{
+		Config.ContactBoneNames = CustomContactBones;
+	}
 	Config.bOpenInEditor = true;
 
 	// Grid settings
@@ -1176,7 +1780,8 @@ FBlendSpaceBuildConfig SBlendSpaceConfigDialog::GetBuildConfig() const
 EVisibility SBlendSpaceConfigDialog::GetFootBoneVisibility() const
 {
 	return (SelectedAnalysisType == EBlendSpaceAnalysisType::LocomotionSimple ||
-			SelectedAnalysisType == EBlendSpaceAnalysisType::LocomotionStride)
+			SelectedAnalysisType == EBlendSpaceAnalysisType::LocomotionStride ||
+			SelectedAnalysisType == EBlendSpaceAnalysisType::Auto)
 		? EVisibility::Visible
 		: EVisibility::Collapsed;
 }
@@ -1217,11 +1822,49 @@ FText SBlendSpaceConfigDialog::GetAnalysisResultsText() const
 		if (PosPtr)
 		{
 			FString AnimName = Anim->GetName();
-			ResultStr += FString::Printf(TEXT("%s: (%.0f, %.0f)\n"),
+			ResultStr += FString::Printf(TEXT("%s: (%.0f, %.0f)"),
 				*AnimName, PosPtr->X, PosPtr->Y);
+
+			// Show error estimate for coarse results and the curve an exact result was read from
+			const FBlendSpaceAnalysisResult* Result = AnalysisResults.Find(Anim);
+			if (Result && !Result->IsExact())
+			{
+				ResultStr += FString::Printf(TEXT(" \u00B1%.0f"), Result->ErrorEstimate);
+			}
+			else if (Result && !Result->SourceCurveName.IsNone())
+			{
+				ResultStr += FString::Printf(TEXT(" [curve: %s]"), *Result->SourceCurveName.ToString());
+			}
+
+			// Mirrored partners reuse the reflected result of their source
+			if (Result && Result->MirrorSource)
+			{
+				ResultStr += FString::Printf(TEXT(" [mirror of %s]"), *Result->MirrorSource->GetName());
+			}
+
+			if (Result && Result->RetargetSource.IsValid())
+			{
+				ResultStr += FString::Printf(TEXT(" [retarget of %s]"), *Result->RetargetSource.GetAssetName());
+			}
+
+			// Report the mode Auto picked for this sample
+			if (Result && SelectedAnalysisType == EBlendSpaceAnalysisType::Auto)
+			{
+				ResultStr += (Result->ResolvedAnalysisType == EBlendSpaceAnalysisType::RootMotion)
+					? TEXT(" [root motion]")
+					: TEXT(" [feet]");
+			}
+			ResultStr += TEXT("\n");
 		}
 	}
 
+	const UBlendSpaceBuilderSettings* Settings = UBlendSpaceBuilderSettings::Get();
+	if (Settings->bUseDerivedDataCache || Settings->bUseAnalysisCacheFile)
+	{
+		const FBlendSpaceAnalysisDerivedData::FStats Stats = FBlendSpaceAnalysisDerivedData::GetStats();
+		ResultStr += FString::Printf(TEXT("Analysis cache: %d hit(s) (%d from cache file), %d miss(es)\n"), Stats.Hits, Stats.FileHits, Stats.Misses);
+	}
+
 	return FText::FromString(ResultStr.TrimEnd());
 }
 
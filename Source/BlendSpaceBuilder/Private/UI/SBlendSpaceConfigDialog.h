@@ -3,6 +3,9 @@
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/DeclarativeSyntaxSupport.h"
+#include "UObject/GCObject.h"
+#include "UObject/ObjectKey.h"
+#include "Tasks/Task.h"
 #include "BlendSpaceFactory.h"
 
 class USkeleton;
@@ -13,7 +16,7 @@ enum class ELocomotionRole : uint8;
 
 DECLARE_DELEGATE_OneParam(FOnBlendSpaceConfigAccepted, const FBlendSpaceBuildConfig&);
 
-class SBlendSpaceConfigDialog : public SCompoundWidget
+class SBlendSpaceConfigDialog : public SCompoundWidget, public FGCObject
 {
 public:
 	SLATE_BEGIN_ARGS(SBlendSpaceConfigDialog) {}
@@ -25,10 +28,15 @@ public:
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
+	virtual ~SBlendSpaceConfigDialog();
 
 	bool WasAccepted() const { return bWasAccepted; }
 	FBlendSpaceBuildConfig GetBuildConfig() const;
 
+	// FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("SBlendSpaceConfigDialog"); }
+
 private:
 	TSharedRef<SWidget> BuildAxisConfigSection();
 	TSharedRef<SWidget> BuildAnimationSelectionSection();
@@ -72,11 +80,51 @@ private:
 	FName CustomLeftFootBone = NAME_None;
 	FName CustomRightFootBone = NAME_None;
 
-	// Analysis results (populated by Analyze button)
+	// Custom contact bones (quadrupeds/creatures), override the foot bones when set
+	TArray<FName> CustomContactBones;
+
+	// Analysis quality preset (Fast/Balanced results are refined in the background)
+	EBlendSpaceAnalysisQuality SelectedAnalysisQuality = EBlendSpaceAnalysisQuality::Fast;
+
+	// Analysis results of the current selection (populated by Analyze button)
 	TMap<UAnimSequence*, FVector> AnalyzedPositions;
+	TMap<UAnimSequence*, FBlendSpaceAnalysisResult> AnalysisResults;
+
+	// Every result of this dialog by (animation, analysis settings key), so selection and analysis type
+	// changes only analyze the clips that have no result yet
+	TMap<TPair<FObjectKey, uint32>, FBlendSpaceAnalysisResult> ResultHistory;
 	bool bAnalysisPerformed = false;
 	bool bUseAnalyzedPositions = true;
 
+	// Set while a forced re-analysis launches, so cached results are replaced instead of reused
+	bool bBypassAnalysisCache = false;
+
+	// Background analysis state (generation invalidates results of outdated analyses)
+	int32 AnalysisGeneration = 0;
+	bool bAnalysisInProgress = false;
+	bool bRefinementInProgress = false;
+	int32 NumSamplesToAnalyze = 0;
+	int32 NumSamplesAnalyzed = 0;
+
+	// Analysis tasks still running; their animations stay referenced until each task has finished
+	struct FInFlightAnalysis
+	{
+		UE::Tasks::FTask Task;
+		TSharedPtr<FBlendSpaceAnalysisProgress> Progress;
+		TArray<UAnimSequence*> Animations;
+		int32 Generation = 0;
+		bool bRefinement = false;
+
+		/** Launched by a forced re-analysis; its refinement bypasses the caches as well */
+		bool bBypassCache = false;
+	};
+	TMap<int32, FInFlightAnalysis> InFlightAnalyses;
+	int32 NextAnalysisTaskId = 0;
+
+	// Speculative analysis of the recommended clips and top alternates into the analysis cache
+	FInFlightAnalysis PrefetchAnalysis;
+	int32 PrefetchGeneration = 0;
+
 	// Max speed from analysis (used for Reset to Role Defaults)
 	float AnalyzedMaxSpeed = 0.f;
 
@@ -99,13 +147,33 @@ private:
 
 	// Event handlers
 	FReply OnAnalyzeClicked();
+	FReply OnForceReanalyzeClicked();
+	FReply OnCancelAnalysisClicked();
 	FReply OnResetToRoleDefaultsClicked();
 	void OnAnalysisTypeChanged(EBlendSpaceAnalysisType NewType);
+	void OnAnalysisQualityChanged(EBlendSpaceAnalysisQuality NewQuality);
 	void OnGridDivisionsChanged(int32 NewValue);
 	void OnSnapToGridChanged(ECheckBoxState NewState);
 	void OnUseNiceNumbersChanged(ECheckBoxState NewState);
 	void RecalculateAxisRange();
 
+	// Analysis helpers
+	FBlendSpaceAnalysisOptions MakeAnalysisOptions() const;
+	uint32 GetAnalysisSettingsKey() const;
+	void ApplySampleResult(UAnimSequence* Animation, const FBlendSpaceAnalysisResult& Result);
+	void SyncAnalysisWithSelection();
+	void UpdateAnalyzedSpeeds();
+	void StartAnalysis(bool bBypassCache);
+	void StartBackgroundRefinement(const TArray<UAnimSequence*>& Animations, bool bBypassCache = false);
+	void LaunchAnalysis(const TMap<ELocomotionRole, UAnimSequence*>& Animations, const FBlendSpaceAnalysisOptions& Options, bool bRefinement);
+	void OnSampleAnalyzed(UAnimSequence* Animation, const FBlendSpaceAnalysisResult& Result, int32 Generation, uint32 SettingsKey, float InScaleDivisor, bool bRefinement);
+	void OnAnalysisTaskCompleted(int32 TaskId, int32 Generation, bool bRefinement);
+	void UpdateAnalysisProgressState();
+	void CancelAnalysisTasks();
+	void StartPrefetch();
+	void CancelPrefetch();
+	void OnPrefetchCompleted(int32 Generation);
+
 	// UI helpers
 	EVisibility GetFootBoneVisibility() const;
 	EVisibility GetAnalysisResultsVisibility() const;
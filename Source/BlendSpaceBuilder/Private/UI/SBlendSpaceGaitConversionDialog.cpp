@@ -3,6 +3,7 @@
 
 #include "Animation/BlendSpace.h"
 #include "Animation/AnimSequence.h"
+#include "Async/Async.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SScrollBox.h"
@@ -10,13 +11,120 @@
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/SNullWidget.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/SHeaderRow.h"
 #include "Styling/AppStyle.h"
 
 #define LOCTEXT_NAMESPACE "SBlendSpaceGaitConversionDialog"
 
+namespace GaitConversionPreviewColumns
+{
+	static const FName Include(TEXT("Include"));
+	static const FName Name(TEXT("Name"));
+	static const FName SpeedPosition(TEXT("SpeedPosition"));
+	static const FName Role(TEXT("Role"));
+	static const FName GaitPosition(TEXT("GaitPosition"));
+}
+
+/**
+ * Preview table row: an asset with its include checkbox and status, or one of its samples.
+ */
+class SGaitConversionPreviewRow : public SMultiColumnTableRow<TSharedPtr<SBlendSpaceGaitConversionDialog::FPreviewRow>>
+{
+public:
+	SLATE_BEGIN_ARGS(SGaitConversionPreviewRow) {}
+		SLATE_ARGUMENT(TSharedPtr<SBlendSpaceGaitConversionDialog::FPreviewRow>, Row)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+	{
+		Row = InArgs._Row;
+		FSuperRowType::Construct(FSuperRowType::FArguments(), OwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		using namespace GaitConversionPreviewColumns;
+
+		TSharedPtr<SBlendSpaceGaitConversionDialog::FAssetEntry> Asset = Row->Asset;
+		if (!Row->Animation)
+		{
+			if (ColumnName == Include)
+			{
+				return SNew(SCheckBox)
+					.IsEnabled_Lambda([Asset]() { return Asset->IsReady(); })
+					.IsChecked_Lambda([Asset]() { return Asset->bIncluded && Asset->IsReady() ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+					.OnCheckStateChanged_Lambda([Asset](ECheckBoxState NewState) { Asset->bIncluded = (NewState == ECheckBoxState::Checked); });
+			}
+			if (ColumnName == Name)
+			{
+				return SNew(STextBlock)
+					.Text(FText::FromString(Asset->BlendSpace ? Asset->BlendSpace->GetName() : FString()))
+					.Font(FCoreStyle::GetDefaultFontStyle("Bold", 9));
+			}
+			if (ColumnName == Role)
+			{
+				return SNew(STextBlock)
+					.Text_Lambda([Asset]()
+					{
+						if (!Asset->bAnalyzed)
+						{
+							return LOCTEXT("AssetAnalyzing", "Analyzing...");
+						}
+						if (!Asset->Result.bSuccess)
+						{
+							return FText::Format(LOCTEXT("AssetError", "Error: {0}"), FText::FromString(Asset->Result.ErrorMessage));
+						}
+						return FText::Format(LOCTEXT("AssetSampleCount", "{0} samples"), FText::AsNumber(Asset->Result.InferredRoles.Num()));
+					});
+			}
+			return SNullWidget::NullWidget;
+		}
+
+		FText Text;
+		if (ColumnName == Name)
+		{
+			Text = FText::FromString(Row->Animation->GetName());
+		}
+		else if (ColumnName == SpeedPosition)
+		{
+			const FVector2D Position = Asset->Result.OriginalSpeedPositions.FindRef(Row->Animation);
+			Text = FText::FromString(FString::Printf(TEXT("(%.0f, %.0f)"), Position.X, Position.Y));
+		}
+		else if (ColumnName == Role)
+		{
+			Text = FText::FromString(UBlendSpaceBuilderSettings::GetRoleDisplayName(Asset->Result.InferredRoles.FindRef(Row->Animation)));
+		}
+		else if (ColumnName == GaitPosition)
+		{
+			const FVector2D Position = Asset->Result.NewGaitPositions.FindRef(Row->Animation);
+			Text = FText::FromString(FString::Printf(TEXT("(%.0f, %.0f)"), Position.X, Position.Y));
+		}
+		else
+		{
+			return SNullWidget::NullWidget;
+		}
+
+		// Samples of excluded assets are dimmed
+		return SNew(STextBlock)
+			.Text(Text)
+			.ColorAndOpacity_Lambda([Asset]() { return Asset->bIncluded ? FSlateColor::UseForeground() : FSlateColor::UseSubduedForeground(); })
+			.Margin(ColumnName == Name ? FMargin(12.f, 0.f, 0.f, 0.f) : FMargin(0.f));
+	}
+
+private:
+	TSharedPtr<SBlendSpaceGaitConversionDialog::FPreviewRow> Row;
+};
+
 void SBlendSpaceGaitConversionDialog::Construct(const FArguments& InArgs)
 {
-	SourceBlendSpace = InArgs._BlendSpace;
+	for (UBlendSpace* BlendSpace : InArgs._BlendSpaces)
+	{
+		TSharedPtr<FAssetEntry> Asset = MakeShared<FAssetEntry>();
+		Asset->BlendSpace = BlendSpace;
+		Assets.Add(Asset);
+	}
 	ParentWindow = InArgs._ParentWindow;
 
 	// Default config - in-place conversion by default
@@ -77,6 +185,20 @@ void SBlendSpaceGaitConversionDialog::Construct(const FArguments& InArgs)
 	OnAnalyzeClicked();
 }
 
+SBlendSpaceGaitConversionDialog::~SBlendSpaceGaitConversionDialog()
+{
+	// Tasks read the BlendSpaces this dialog keeps referenced
+	UE::Tasks::Wait(AnalysisTasks);
+}
+
+void SBlendSpaceGaitConversionDialog::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (const TSharedPtr<FAssetEntry>& Asset : Assets)
+	{
+		Collector.AddReferencedObject(Asset->BlendSpace);
+	}
+}
+
 TSharedRef<SWidget> SBlendSpaceGaitConversionDialog::BuildSourceInfoSection()
 {
 	return SNew(SVerticalBox)
@@ -115,20 +237,43 @@ TSharedRef<SWidget> SBlendSpaceGaitConversionDialog::BuildSampleAnalysisSection(
 			.Padding(5.f)
 			.Visibility(this, &SBlendSpaceGaitConversionDialog::GetAnalysisResultsVisibility)
 			[
-				SNew(SScrollBox)
-				+ SScrollBox::Slot()
-				[
-					SAssignNew(SampleAnalysisTextBlock, STextBlock)
-					.Text(this, &SBlendSpaceGaitConversionDialog::GetSampleAnalysisText)
-				]
+				SAssignNew(PreviewList, SListView<TSharedPtr<FPreviewRow>>)
+				.ListItemsSource(&Rows)
+				.SelectionMode(ESelectionMode::None)
+				.OnGenerateRow(this, &SBlendSpaceGaitConversionDialog::OnGenerateRow)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(GaitConversionPreviewColumns::Include)
+					.DefaultLabel(FText::GetEmpty())
+					.FixedWidth(24.f)
+					+ SHeaderRow::Column(GaitConversionPreviewColumns::Name)
+					.DefaultLabel(LOCTEXT("NameColumn", "Asset / Sample"))
+					.FillWidth(0.4f)
+					+ SHeaderRow::Column(GaitConversionPreviewColumns::SpeedPosition)
+					.DefaultLabel(LOCTEXT("SpeedPositionColumn", "Speed"))
+					.FillWidth(0.2f)
+					+ SHeaderRow::Column(GaitConversionPreviewColumns::Role)
+					.DefaultLabel(LOCTEXT("RoleColumn", "Role"))
+					.FillWidth(0.2f)
+					+ SHeaderRow::Column(GaitConversionPreviewColumns::GaitPosition)
+					.DefaultLabel(LOCTEXT("GaitPositionColumn", "Gait"))
+					.FillWidth(0.2f)
+				)
 			]
 		];
 }
 
+TSharedRef<ITableRow> SBlendSpaceGaitConversionDialog::OnGenerateRow(TSharedPtr<FPreviewRow> Row, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SGaitConversionPreviewRow, OwnerTable)
+		.Row(Row);
+}
+
 TSharedRef<SWidget> SBlendSpaceGaitConversionDialog::BuildAnalyzedSpeedsSection()
 {
 	return SNew(SVerticalBox)
-		.Visibility(this, &SBlendSpaceGaitConversionDialog::GetAnalysisResultsVisibility)
+		.Visibility(this, &SBlendSpaceGaitConversionDialog::GetAnalyzedSpeedsVisibility)
 		+ SVerticalBox::Slot()
 		.AutoHeight()
 		[
@@ -140,7 +285,7 @@ TSharedRef<SWidget> SBlendSpaceGaitConversionDialog::BuildAnalyzedSpeedsSection(
 		.AutoHeight()
 		.Padding(10.f, 5.f, 0.f, 0.f)
 		[
-			SAssignNew(AnalyzedSpeedsTextBlock, STextBlock)
+			SNew(STextBlock)
 			.Text(this, &SBlendSpaceGaitConversionDialog::GetAnalyzedSpeedsText)
 		]
 		+ SVerticalBox::Slot()
@@ -155,7 +300,7 @@ TSharedRef<SWidget> SBlendSpaceGaitConversionDialog::BuildAnalyzedSpeedsSection(
 		.AutoHeight()
 		.Padding(10.f, 5.f, 0.f, 0.f)
 		[
-			SAssignNew(RecommendedThresholdsTextBlock, STextBlock)
+			SNew(STextBlock)
 			.Text(this, &SBlendSpaceGaitConversionDialog::GetRecommendedThresholdsText)
 		];
 }
@@ -249,9 +394,14 @@ TSharedRef<SWidget> SBlendSpaceGaitConversionDialog::BuildButtonSection()
 		.Padding(5.f, 0.f)
 		[
 			SNew(SButton)
-			.Text(LOCTEXT("ConvertButton", "Convert"))
+			.Text_Lambda([this]()
+			{
+				return Assets.Num() > 1
+					? FText::Format(LOCTEXT("ConvertCountButton", "Convert ({0})"), FText::AsNumber(GetNumIncludedReady()))
+					: LOCTEXT("ConvertButton", "Convert");
+			})
 			.OnClicked(this, &SBlendSpaceGaitConversionDialog::OnConvertClicked)
-			.IsEnabled_Lambda([this]() { return bAnalysisPerformed && AnalysisResult.bSuccess; })
+			.IsEnabled(this, &SBlendSpaceGaitConversionDialog::CanConvert)
 		]
 		+ SHorizontalBox::Slot()
 		.AutoWidth()
@@ -265,33 +415,146 @@ TSharedRef<SWidget> SBlendSpaceGaitConversionDialog::BuildButtonSection()
 
 FReply SBlendSpaceGaitConversionDialog::OnAnalyzeClicked()
 {
-	if (SourceBlendSpace)
+	// Results of a previous click still in flight are dropped
+	++AnalysisGeneration;
+	NumAssetsAnalyzed = 0;
+	bAnalysisPerformed = true;
+	AnalysisTasks.RemoveAll([](const UE::Tasks::FTask& Task) { return Task.IsCompleted(); });
+
+	// One task per BlendSpace; each asset's rows appear as soon as its analysis is done
+	TWeakPtr<SBlendSpaceGaitConversionDialog> WeakDialog = StaticCastSharedRef<SBlendSpaceGaitConversionDialog>(AsShared());
+	const int32 Generation = AnalysisGeneration;
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
 	{
-		AnalysisResult = FBlendSpaceGaitConverter::AnalyzeBlendSpace(SourceBlendSpace, Config);
-		bAnalysisPerformed = true;
+		FAssetEntry& Asset = *Assets[AssetIndex];
+		Asset.Result = FGaitConversionResult();
+		Asset.bAnalyzed = false;
+
+		// AnalyzeBlendSpace only reads the sample list and axis parameters
+		UBlendSpace* BlendSpace = Asset.BlendSpace;
+		AnalysisTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakDialog, BlendSpace, TaskConfig = Config, AssetIndex, Generation]()
+		{
+			FGaitConversionResult Result = FBlendSpaceGaitConverter::AnalyzeBlendSpace(BlendSpace, TaskConfig);
+			AsyncTask(ENamedThreads::GameThread, [WeakDialog, AssetIndex, Generation, Result = MoveTemp(Result)]()
+			{
+				if (TSharedPtr<SBlendSpaceGaitConversionDialog> Dialog = WeakDialog.Pin())
+				{
+					Dialog->OnAssetAnalyzed(AssetIndex, Generation, Result);
+				}
+			});
+		}));
 	}
+
+	RebuildRows();
 	return FReply::Handled();
 }
 
-FReply SBlendSpaceGaitConversionDialog::OnConvertClicked()
+void SBlendSpaceGaitConversionDialog::OnAssetAnalyzed(int32 AssetIndex, int32 Generation, const FGaitConversionResult& Result)
 {
-	if (SourceBlendSpace && bAnalysisPerformed && AnalysisResult.bSuccess)
+	if (Generation != AnalysisGeneration || !Assets.IsValidIndex(AssetIndex))
 	{
-		FGaitConversionResult ConversionResult;
-		ConvertedBlendSpace = FBlendSpaceGaitConverter::ConvertToGaitBased(SourceBlendSpace, Config, ConversionResult);
+		return;
+	}
+
+	FAssetEntry& Asset = *Assets[AssetIndex];
+	Asset.Result = Result;
+	Asset.bAnalyzed = true;
+	++NumAssetsAnalyzed;
 
-		if (ConvertedBlendSpace)
+	// Many results can arrive in one frame; rebuilding for each would re-create every row every time
+	if (!bRowsDirty)
+	{
+		bRowsDirty = true;
+		RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateSP(this, &SBlendSpaceGaitConversionDialog::RebuildDirtyRows));
+	}
+}
+
+EActiveTimerReturnType SBlendSpaceGaitConversionDialog::RebuildDirtyRows(double InCurrentTime, float InDeltaTime)
+{
+	if (bRowsDirty)
+	{
+		RebuildRows();
+	}
+	return EActiveTimerReturnType::Stop;
+}
+
+void SBlendSpaceGaitConversionDialog::RebuildRows()
+{
+	bRowsDirty = false;
+	Rows.Reset();
+	for (const TSharedPtr<FAssetEntry>& Asset : Assets)
+	{
+		TSharedPtr<FPreviewRow> AssetRow = MakeShared<FPreviewRow>();
+		AssetRow->Asset = Asset;
+		Rows.Add(AssetRow);
+
+		if (!Asset->IsReady())
+		{
+			continue;
+		}
+
+		// Sample order of the BlendSpace
+		for (const FBlendSample& Sample : Asset->BlendSpace->GetBlendSamples())
 		{
-			bWasAccepted = true;
-			if (ParentWindow.IsValid())
+			UAnimSequence* Animation = Cast<UAnimSequence>(Sample.Animation);
+			if (Animation && Asset->Result.InferredRoles.Contains(Animation))
 			{
-				ParentWindow->RequestDestroyWindow();
+				TSharedPtr<FPreviewRow> SampleRow = MakeShared<FPreviewRow>();
+				SampleRow->Asset = Asset;
+				SampleRow->Animation = Animation;
+				Rows.Add(SampleRow);
 			}
 		}
 	}
+
+	if (PreviewList.IsValid())
+	{
+		PreviewList->RequestListRefresh();
+	}
+}
+
+FReply SBlendSpaceGaitConversionDialog::OnConvertClicked()
+{
+	// The preview's analyses are converted as they are; only the output options can change after Analyze
+	TArray<UBlendSpace*> BlendSpacesToConvert;
+	TArray<FGaitConversionResult> Analyses;
+	for (const TSharedPtr<FAssetEntry>& Asset : Assets)
+	{
+		if (Asset->bIncluded && Asset->IsReady())
+		{
+			BlendSpacesToConvert.Add(Asset->BlendSpace);
+			Analyses.Add(Asset->Result);
+		}
+	}
+
+	if (BlendSpacesToConvert.Num() > 0)
+	{
+		FBlendSpaceGaitConverter::ConvertBatch(BlendSpacesToConvert, MoveTemp(Analyses), Config);
+
+		bWasAccepted = true;
+		if (ParentWindow.IsValid())
+		{
+			ParentWindow->RequestDestroyWindow();
+		}
+	}
 	return FReply::Handled();
 }
 
+bool SBlendSpaceGaitConversionDialog::CanConvert() const
+{
+	return bAnalysisPerformed && NumAssetsAnalyzed == Assets.Num() && GetNumIncludedReady() > 0;
+}
+
+int32 SBlendSpaceGaitConversionDialog::GetNumIncludedReady() const
+{
+	int32 NumIncluded = 0;
+	for (const TSharedPtr<FAssetEntry>& Asset : Assets)
+	{
+		NumIncluded += (Asset->bIncluded && Asset->IsReady()) ? 1 : 0;
+	}
+	return NumIncluded;
+}
+
 FReply SBlendSpaceGaitConversionDialog::OnCancelClicked()
 {
 	bWasAccepted = false;
@@ -319,11 +582,26 @@ void SBlendSpaceGaitConversionDialog::OnOutputSuffixChanged(const FText& NewText
 
 FText SBlendSpaceGaitConversionDialog::GetSourceInfoText() const
 {
-	if (!SourceBlendSpace)
+	if (Assets.Num() == 0)
 	{
 		return LOCTEXT("NoBlendSpace", "No BlendSpace selected");
 	}
 
+	if (Assets.Num() > 1)
+	{
+		int32 NumSamples = 0;
+		for (const TSharedPtr<FAssetEntry>& Asset : Assets)
+		{
+			NumSamples += Asset->BlendSpace->GetBlendSamples().Num();
+		}
+		return FText::Format(
+			LOCTEXT("MultiSourceInfoFormat", "BlendSpaces: {0} ({1} samples)\nAnalyzed: {2} / {0}"),
+			FText::AsNumber(Assets.Num()),
+			FText::AsNumber(NumSamples),
+			FText::AsNumber(NumAssetsAnalyzed));
+	}
+
+	const UBlendSpace* SourceBlendSpace = Assets[0]->BlendSpace;
 	const FBlendParameter& XParam = SourceBlendSpace->GetBlendParameter(0);
 	const FBlendParameter& YParam = SourceBlendSpace->GetBlendParameter(1);
 
@@ -337,50 +615,13 @@ FText SBlendSpaceGaitConversionDialog::GetSourceInfoText() const
 		FText::AsNumber(SourceBlendSpace->GetBlendSamples().Num()));
 }
 
-FText SBlendSpaceGaitConversionDialog::GetSampleAnalysisText() const
-{
-	if (!bAnalysisPerformed)
-	{
-		return LOCTEXT("ClickAnalyze", "Click Analyze to preview conversion");
-	}
-
-	if (!AnalysisResult.bSuccess)
-	{
-		return FText::Format(LOCTEXT("AnalysisError", "Error: {0}"), FText::FromString(AnalysisResult.ErrorMessage));
-	}
-
-	FString ResultText;
-	for (const auto& Pair : AnalysisResult.OriginalSpeedPositions)
-	{
-		UAnimSequence* Anim = Pair.Key;
-		if (!Anim)
-		{
-			continue;
-		}
-
-		FVector2D OriginalPos = Pair.Value;
-		ELocomotionRole Role = AnalysisResult.InferredRoles.FindRef(Anim);
-		FVector2D NewPos = AnalysisResult.NewGaitPositions.FindRef(Anim);
-
-		FString RoleName = UBlendSpaceBuilderSettings::GetRoleDisplayName(Role);
-
-		ResultText += FString::Printf(
-			TEXT("%s\n  (%.0f, %.0f) -> %s (%.0f, %.0f)\n"),
-			*Anim->GetName(),
-			OriginalPos.X, OriginalPos.Y,
-			*RoleName,
-			NewPos.X, NewPos.Y);
-	}
-
-	return FText::FromString(ResultText);
-}
-
 FText SBlendSpaceGaitConversionDialog::GetAnalyzedSpeedsText() const
 {
-	if (!bAnalysisPerformed || !AnalysisResult.bSuccess)
+	if (Assets.Num() != 1 || !Assets[0]->IsReady())
 	{
 		return FText::GetEmpty();
 	}
+	const FGaitConversionResult& AnalysisResult = Assets[0]->Result;
 
 	return FText::Format(
 		LOCTEXT("AnalyzedSpeedsFormat", "Walk: {0} cm/s | Run: {1} cm/s"),
@@ -390,10 +631,11 @@ FText SBlendSpaceGaitConversionDialog::GetAnalyzedSpeedsText() const
 
 FText SBlendSpaceGaitConversionDialog::GetRecommendedThresholdsText() const
 {
-	if (!bAnalysisPerformed || !AnalysisResult.bSuccess)
+	if (Assets.Num() != 1 || !Assets[0]->IsReady())
 	{
 		return FText::GetEmpty();
 	}
+	const FGaitConversionResult& AnalysisResult = Assets[0]->Result;
 
 	// Calculate recommended thresholds based on analyzed speeds
 	float IdleToWalk = AnalysisResult.AnalyzedWalkSpeed * 0.1f;
@@ -412,4 +654,10 @@ EVisibility SBlendSpaceGaitConversionDialog::GetAnalysisResultsVisibility() cons
 	return bAnalysisPerformed ? EVisibility::Visible : EVisibility::Collapsed;
 }
 
+EVisibility SBlendSpaceGaitConversionDialog::GetAnalyzedSpeedsVisibility() const
+{
+	// Speeds and thresholds are per asset, so they are only shown for a single BlendSpace
+	return (Assets.Num() == 1 && Assets[0]->IsReady()) ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -3,26 +3,54 @@
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/DeclarativeSyntaxSupport.h"
+#include "Widgets/Views/SListView.h"
+#include "UObject/GCObject.h"
+#include "Tasks/Task.h"
 #include "BlendSpaceGaitConverter.h"
 
 class UBlendSpace;
+class ITableRow;
+class STableViewBase;
 
 /**
- * Dialog for converting Speed-based BlendSpace to Gait-based format.
- * Shows preview of sample role inference and conversion results.
+ * Dialog for converting Speed-based BlendSpaces to Gait-based format.
+ * Analyzes every selected BlendSpace on background tasks and fills a per-asset, per-sample preview
+ * table as results arrive; assets can be excluded before they are converted in one batch.
  */
-class SBlendSpaceGaitConversionDialog : public SCompoundWidget
+class SBlendSpaceGaitConversionDialog : public SCompoundWidget, public FGCObject
 {
 public:
 	SLATE_BEGIN_ARGS(SBlendSpaceGaitConversionDialog) {}
-		SLATE_ARGUMENT(UBlendSpace*, BlendSpace)
+		SLATE_ARGUMENT(TArray<UBlendSpace*>, BlendSpaces)
 		SLATE_ARGUMENT(TSharedPtr<SWindow>, ParentWindow)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
+	virtual ~SBlendSpaceGaitConversionDialog();
 
 	bool WasAccepted() const { return bWasAccepted; }
-	UBlendSpace* GetConvertedBlendSpace() const { return ConvertedBlendSpace; }
+
+	// FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("SBlendSpaceGaitConversionDialog"); }
+
+	/** One selected BlendSpace and its preview */
+	struct FAssetEntry
+	{
+		UBlendSpace* BlendSpace = nullptr;
+		FGaitConversionResult Result;
+		bool bAnalyzed = false;
+		bool bIncluded = true;
+
+		bool IsReady() const { return bAnalyzed && Result.bSuccess; }
+	};
+
+	/** Table row: an asset header (Animation is null) or one of its samples */
+	struct FPreviewRow
+	{
+		TSharedPtr<FAssetEntry> Asset;
+		UAnimSequence* Animation = nullptr;
+	};
 
 private:
 	TSharedRef<SWidget> BuildSourceInfoSection();
@@ -31,33 +59,47 @@ private:
 	TSharedRef<SWidget> BuildOptionsSection();
 	TSharedRef<SWidget> BuildButtonSection();
 
+	TSharedRef<ITableRow> OnGenerateRow(TSharedPtr<FPreviewRow> Row, const TSharedRef<STableViewBase>& OwnerTable);
+
 	FReply OnAnalyzeClicked();
 	FReply OnConvertClicked();
 	FReply OnCancelClicked();
 
+	void OnAssetAnalyzed(int32 AssetIndex, int32 Generation, const FGaitConversionResult& Result);
+	void RebuildRows();
+	EActiveTimerReturnType RebuildDirtyRows(double InCurrentTime, float InDeltaTime);
+
 	void OnCreateCopyChanged(ECheckBoxState NewState);
 	void OnOpenInEditorChanged(ECheckBoxState NewState);
 	void OnOutputSuffixChanged(const FText& NewText);
 
 	FText GetSourceInfoText() const;
-	FText GetSampleAnalysisText() const;
 	FText GetAnalyzedSpeedsText() const;
 	FText GetRecommendedThresholdsText() const;
 
 	EVisibility GetAnalysisResultsVisibility() const;
+	EVisibility GetAnalyzedSpeedsVisibility() const;
+
+	bool CanConvert() const;
+	int32 GetNumIncludedReady() const;
 
-	UBlendSpace* SourceBlendSpace = nullptr;
+	TArray<TSharedPtr<FAssetEntry>> Assets;
 	TSharedPtr<SWindow> ParentWindow;
 
 	FGaitConversionConfig Config;
-	FGaitConversionResult AnalysisResult;
 	bool bAnalysisPerformed = false;
 
+	// Background analysis (generation invalidates results of a previous Analyze click)
+	TArray<UE::Tasks::FTask> AnalysisTasks;
+	int32 AnalysisGeneration = 0;
+	int32 NumAssetsAnalyzed = 0;
+
 	bool bWasAccepted = false;
-	UBlendSpace* ConvertedBlendSpace = nullptr;
 
-	// UI update
-	TSharedPtr<STextBlock> SampleAnalysisTextBlock;
-	TSharedPtr<STextBlock> AnalyzedSpeedsTextBlock;
-	TSharedPtr<STextBlock> RecommendedThresholdsTextBlock;
+	// Preview table (virtualized, one row per asset and per sample)
+	TArray<TSharedPtr<FPreviewRow>> Rows;
+	TSharedPtr<SListView<TSharedPtr<FPreviewRow>>> PreviewList;
+
+	/** Results arrived since the last rebuild; rows are rebuilt at most once per frame */
+	bool bRowsDirty = false;
 };
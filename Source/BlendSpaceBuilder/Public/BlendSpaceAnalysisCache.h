@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlendSpaceFactory.h"
+#include "BlendSpaceAnalysisDerivedData.h"
+#include "Misc/SecureHash.h"
+
+class UAnimSequence;
+class USkeleton;
+
+/**
+ * Editor-session cache of per-animation analysis results.
+ * Results are keyed by FBlendSpaceAnalysisDerivedData::GetInputHash (the clip's data model GUID, rate scale, looping, markers,
+ * notifies, skeleton and the full settings snapshot), so editing a clip or a setting misses the cache.
+ * With bReuseRetargetedAnalysis (opt-in), lets retargeted copies of an analyzed clip on other skeletons
+ * reuse the source result, rescaled by the ratio of the skeletons' leg lengths, instead of evaluating bones again.
+ * Thread-safe: analysis may run on background tasks.
+ */
+class BLENDSPACEBUILDER_API FBlendSpaceAnalysisCache
+{
+public:
+	static FBlendSpaceAnalysisCache& Get();
+
+	/**
+	 * Store the analysis of an animation (before stride multiplier / role direction) under its requested input hash.
+	 * Options must carry a settings snapshot.
+	 */
+	void Store(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, const FSHAHash& InputHash, const FBlendSpaceAnalysisResult& Result);
+
+	/**
+	 * Find a cached analysis of Animation itself with the same inputs, options and bones.
+	 * An Exact result also satisfies a request at a coarser quality. Always misses with Options.bBypassCache.
+	 */
+	bool FindResult(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, const FBlendSpaceAnalysisDerivedData::FInputHashes& Hashes, FBlendSpaceAnalysisResult& OutResult) const;
+
+	/**
+	 * Find a cached analysis of the clip Animation was retargeted from: same name (ignoring suffixes),
+	 * frame count and sync marker timing on a different skeleton, analyzed with the same options.
+	 * @param OutResult Source result with velocity rescaled to the target skeleton
+	 */
+	bool FindRetargetedResult(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, FBlendSpaceAnalysisResult& OutResult) const;
+
+	/** Drop every cached result */
+	void Reset();
+
+	int32 Num() const;
+
+private:
+	/** Retarget candidate: enough about a cached clip to match copies of it on other skeletons */
+	struct FRetargetEntry
+	{
+		FSoftObjectPath AnimationPath;
+		FSoftObjectPath SkeletonPath;
+		int32 NumFrames = 0;
+		uint32 TimingHash = 0;
+		FSHAHash OptionsHash;
+		float LegLength = 0.f;
+		FBlendSpaceAnalysisResult Result;
+	};
+
+	static FString GetMatchName(const UAnimSequence* Animation, const FBlendSpaceAnalysisSettings& Settings);
+	static float GetLegLength(const USkeleton* Skeleton, const FBlendSpaceAnalysisSettings& Settings);
+
+	/** Rate scale, looping and sync marker names and times, which retargeting keeps unchanged */
+	static uint32 GetTimingHash(const UAnimSequence* Animation);
+
+	mutable FCriticalSection CriticalSection;
+	TMap<FSHAHash, FBlendSpaceAnalysisResult> Results;
+
+	/** Retarget candidates by match name; one entry per source clip and options */
+	TMap<FString, TArray<FRetargetEntry>> RetargetEntries;
+};
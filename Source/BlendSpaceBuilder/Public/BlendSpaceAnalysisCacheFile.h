@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlendSpaceFactory.h"
+#include "Misc/SecureHash.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * One analysis result in the portable cache file. Fixed size, so the file is an array of records
+ * sorted by InputHash and looked up by binary search directly in the mapped file.
+ * Stored as raw little-endian bytes: the file is portable between little-endian platforms (every editor platform) only.
+ */
+struct FBlendSpaceAnalysisCacheRecord
+{
+	/** FBlendSpaceAnalysisDerivedData::GetInputHash of the analyzed clip and options */
+	uint8 InputHash[FSHA1::DigestSize];
+
+	/** Velocity before stride multiplier / role direction (X=Right, Y=Forward) */
+	float VelocityX;
+	float VelocityY;
+	float ErrorEstimate;
+	int32 NumKeysEvaluated;
+
+	uint8 Quality;
+	uint8 Source;
+	uint8 ResolvedAnalysisType;
+
+	/** Index into the speed or distance curve names of the settings (-1 when no curve was read) */
+	int8 SourceCurveIndex;
+
+	static FBlendSpaceAnalysisCacheRecord Make(const FSHAHash& InputHash, const FBlendSpaceAnalysisResult& Result, const FBlendSpaceAnalysisSettings& Settings);
+	FBlendSpaceAnalysisResult ToResult(const FBlendSpaceAnalysisSettings& Settings) const;
+
+	/** Finite values and known enum values */
+	bool IsValid() const;
+
+	int32 CompareHash(const uint8* OtherHash) const { return FMemory::Memcmp(InputHash, OtherHash, FSHA1::DigestSize); }
+};
+static_assert(sizeof(FBlendSpaceAnalysisCacheRecord) == 40, "Analysis cache records are stored as raw bytes");
+
+/**
+ * Flat, versioned binary file of analysis results (Saved/BlendSpaceBuilder/Analysis.bsbc by default), written by
+ * the BlendSpaceAnalysis commandlet. CI machines and fresh clones can check it in or copy it to skip analysis
+ * of unchanged clips entirely. The editor maps the file read-only on first use; lookups read records in place.
+ * A file written by another analysis version is ignored as a whole.
+ * Thread-safe once opened.
+ */
+class BLENDSPACEBUILDER_API FBlendSpaceAnalysisCacheFile
+{
+public:
+	static FString GetDefaultPath();
+
+	/**
+	 * Shared instance of the default file (empty when the file is missing or invalid). Remapped when the file on disk
+	 * changes, checked at most once a second; keep the returned reference only for the lookups at hand.
+	 */
+	static TSharedRef<const FBlendSpaceAnalysisCacheFile, ESPMode::ThreadSafe> Get();
+
+	FBlendSpaceAnalysisCacheFile() = default;
+	~FBlendSpaceAnalysisCacheFile();
+
+	/** Map a file (or its newer pending replacement); fails and stays empty when it is missing or does not validate */
+	bool Open(const FString& FilePath, FString* OutError = nullptr);
+
+	bool Find(const FSHAHash& InputHash, const FBlendSpaceAnalysisSettings& Settings, FBlendSpaceAnalysisResult& OutResult) const;
+
+	TConstArrayView<FBlendSpaceAnalysisCacheRecord> GetRecords() const { return Records; }
+
+	/**
+	 * Write records sorted by hash, dropping invalid records and duplicate hashes (the most precise result wins).
+	 * Written to a temporary file and moved, so readers never see a partial file. When the target cannot be replaced
+	 * because an editor has it mapped (Windows), the file is written as a pending replacement next to it instead,
+	 * which Open, Read and the editor's Get pick up while it is the newer of the two.
+	 */
+	static bool Write(const FString& FilePath, TArray<FBlendSpaceAnalysisCacheRecord> InRecords);
+
+	/** Records of a file (or its newer pending replacement) in any order, for merging and compaction; false when the header does not match */
+	static bool Read(const FString& FilePath, TArray<FBlendSpaceAnalysisCacheRecord>& OutRecords, FString* OutError = nullptr);
+
+private:
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TConstArrayView<FBlendSpaceAnalysisCacheRecord> Records;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BlendSpaceAnalysisCommandlet.generated.h"
+
+/**
+ * Whole-library locomotion analysis for nightly jobs, split across local worker processes.
+ *
+ * Coordinator (default):
+ *   -run=BlendSpaceAnalysis [-paths=/Game/A+/Game/B] [-workers=N] [-retries=2] [-memorycapmb=8192] [-output=File.json] [-cachefile=File.bsbc]
+ * Sorts every animation under the paths, launches N workers with -shard=i/N, relaunches failed shards
+ * and merges the shard files into one store sorted by animation path, so the store does not depend on
+ * worker count or completion order. The results are also merged into the portable analysis cache file.
+ *
+ * Worker:
+ *   -run=BlendSpaceAnalysis -shard=i/N [-paths=...] [-memorycapmb=...] [-output=...]
+ * Analyzes shard i, writing results incrementally. A retried worker resumes after the animations its
+ * shard file already holds. Workers collect garbage periodically and exit with a distinct code
+ * when memory stays above the cap, so the coordinator retries them in a fresh process.
+ *
+ * Cache file tool:
+ *   -run=BlendSpaceAnalysis -validatecache [-cachefile=...]
+ *   -run=BlendSpaceAnalysis -compactcache [-prune] [-output=...] [-cachefile=...]
+ * Validate checks the header, record order and record values. Compact rewrites the file sorted and
+ * without invalid or duplicate records; -prune also drops records the store at -output does not reference.
+ */
+UCLASS()
+class UBlendSpaceAnalysisCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBlendSpaceAnalysisCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	int32 RunCoordinator(const FString& Params, const TArray<FSoftObjectPath>& Animations);
+	int32 RunWorker(int32 ShardIndex, int32 NumShards, const TArray<FSoftObjectPath>& Animations);
+	int32 RunCacheFileTool(const FString& Params);
+
+	FString OutputPath;
+	FString CacheFilePath;
+	FString PathsParam;
+	int32 MemoryCapMB = 0;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlendSpaceFactory.h"
+#include "Misc/SecureHash.h"
+
+class UAnimSequence;
+
+/**
+ * Analysis results persisted in the derived data cache, so repeat analyses in later editor sessions
+ * (and teammates sharing a DDC) skip clips that have not changed.
+ * Keys combine the animation's raw data GUID, its rate scale and looping flag, its sync markers and notifies, its skeleton, the analysis type, quality and contact bones,
+ * the analysis settings the result depends on and an analysis version. Results are stored before the
+ * stride multiplier and role direction are applied, like the session cache.
+ * Thread-safe: lookups run on the analysis workers.
+ */
+class BLENDSPACEBUILDER_API FBlendSpaceAnalysisDerivedData
+{
+public:
+	/** Lookups served from and missing in the cache since the editor started */
+	struct FStats
+	{
+		int32 Hits = 0;
+		int32 Misses = 0;
+
+		/** Hits served by the portable analysis cache file before the DDC was asked */
+		int32 FileHits = 0;
+	};
+
+	/** Input hashes of one analysis, computed once per job and shared by the session cache, the cache file and the DDC */
+	struct FInputHashes
+	{
+		/** Hash at Exact quality, whose result satisfies any request */
+		FSHAHash Exact;
+
+		/** Hash at the requested quality (equal to Exact when Exact was requested) */
+		FSHAHash Requested;
+	};
+
+	/**
+	 * Find the result of analyzing Animation with Options, in the portable analysis cache file and then in the DDC.
+	 * An Exact result also satisfies a coarser request. Options must carry a settings snapshot.
+	 */
+	static bool Get(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, const FInputHashes& Hashes, FBlendSpaceAnalysisResult& OutResult);
+
+	/** Store the analysis of an animation (before stride multiplier / role direction) under its requested input hash */
+	static void Put(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, const FSHAHash& InputHash, const FBlendSpaceAnalysisResult& Result);
+
+	static FStats GetStats();
+
+	/** Hash of everything the analysis result depends on; false when the animation has no data model or skeleton */
+	static bool GetInputHash(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, FSHAHash& OutHash);
+
+	/** Requested and Exact input hashes, hashing the animation data only once; false like GetInputHash */
+	static bool GetInputHashes(const UAnimSequence* Animation, const FBlendSpaceAnalysisOptions& Options, FInputHashes& OutHashes);
+
+	/** Hash of the options and settings alone (no animation, skeleton or detected foot bones), shared by retargeted copies */
+	static FSHAHash GetOptionsHash(const FBlendSpaceAnalysisOptions& Options);
+
+	/** Changes whenever the analysis produces different results for the same inputs */
+	static const FGuid& GetAnalysisVersion();
+
+private:
+	static FString GetCacheKey(const FSHAHash& InputHash);
+};
@@ -17,18 +17,25 @@ private:
 	void UnregisterContentBrowserMenuExtension();
 
 	TSharedRef<FExtender> OnExtendContentBrowserAssetSelectionMenu(const TArray<FAssetData>& SelectedAssets);
+	TSharedRef<FExtender> OnExtendContentBrowserPathSelectionMenu(const TArray<FString>& SelectedPaths);
+	void CreatePathMenu(FMenuBuilder& MenuBuilder, TArray<FString> SelectedPaths);
 	void CreateBlendSpaceContextMenu(FMenuBuilder& MenuBuilder, TArray<FAssetData> SelectedAssets);
 	void CreateBlendSpaceUtilityMenu(FMenuBuilder& MenuBuilder, TArray<FAssetData> SelectedAssets);
+	void CreateAnimSequenceMenu(FMenuBuilder& MenuBuilder, TArray<FAssetData> SelectedAssets);
 
 	void ExecuteGenerateLocomotionBlendSpace(TArray<FAssetData> SelectedAssets);
+	void ExecuteBulkGenerateLocomotionBlendSpaces(TArray<FAssetData> SelectedAssets);
+	void ExecuteBulkGenerateInPaths(TArray<FString> SelectedPaths);
 	void ExecuteApplyModifierToAllSamples(TArray<FAssetData> SelectedAssets);
 	void ExecuteOpenAllSamplesInEditor(TArray<FAssetData> SelectedAssets);
 	void ExecuteAdjustAxisRange(TArray<FAssetData> SelectedAssets);
 	void ExecuteConvertToGaitBased(TArray<FAssetData> SelectedAssets);
+	void ExecuteSegmentLocomotionTake(TArray<FAssetData> SelectedAssets);
 
 	// Helper functions
 	TArray<UAnimSequence*> GetAnimationsFromBlendSpace(UBlendSpace* BlendSpace);
 	UClass* ShowModifierClassPicker();
 
 	FDelegateHandle ContentBrowserExtenderDelegateHandle;
+	FDelegateHandle ContentBrowserPathExtenderDelegateHandle;
 };
@@ -4,6 +4,8 @@
 #include "Engine/DeveloperSettings.h"
 #include "BlendSpaceBuilderSettings.generated.h"
 
+class UMirrorDataTable;
+
 UENUM(BlueprintType)
 enum class ELocomotionRole : uint8
 {
@@ -99,11 +101,87 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Output")
 	FString OutputAssetSuffix = TEXT("_Locomotion");
 
+	/** Game-thread time per editor frame for asset creation and batch operations (ms). Work beyond this continues next frame. */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Output", meta = (ClampMin = "1.0", ClampMax = "100.0"))
+	float TimeSliceBudgetMs = 8.0f;
+
+	/** Memory a whole-library batch may grow by (MB) before its loaded assets are released and garbage is collected. 0 keeps everything loaded. */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Output", meta = (ClampMin = "0", ClampMax = "65536"))
+	int32 BatchMemoryBudgetMB = 2048;
+
+	/** Leave existing packages untouched when their saved content would be byte-identical (no timestamp bump or source-control diff) */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Output")
+	bool bSkipUnchangedPackages = true;
+
 	// ============== Locomotion Analysis Settings ==============
 	/** Minimum velocity threshold for root motion analysis (cm/s). Animations below this are considered stationary. */
 	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (ClampMin = "0.0", ClampMax = "100.0"))
 	float MinVelocityThreshold = 1.0f;
 
+	/** Height above the reference pose foot height (cm) within which a foot is considered planted */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (ClampMin = "0.0", ClampMax = "50.0"))
+	float FootContactHeightTolerance = 5.0f;
+
+	/** Maximum vertical foot speed (cm/s) for a foot to be considered planted */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (ClampMin = "0.0", ClampMax = "200.0"))
+	float FootContactMaxVerticalSpeed = 20.0f;
+
+	/** Coarse analysis results whose error estimate is below this (cm/s) are not refined in the background */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (ClampMin = "0.0", ClampMax = "100.0"))
+	float AnalysisErrorTolerance = 5.0f;
+
+	/** Detect repeated stride cycles and analyze only the first one (fixes clips holding several cycles) */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis")
+	bool bDetectLocomotionCycles = true;
+
+	/** Minimum normalized autocorrelation for a repeated cycle to be accepted */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bDetectLocomotionCycles"))
+	float CycleDetectionMinCorrelation = 0.5f;
+
+	/** Analyze only one clip of each left/right mirrored pair (e.g. WalkLeft/WalkRight) and reflect its velocity */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis")
+	bool bReuseMirroredAnalysis = true;
+
+	/** Mirror table providing the mirror axis and bone pairs (left/right foot swap across X when unset) */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (EditCondition = "bReuseMirroredAnalysis"))
+	TSoftObjectPtr<UMirrorDataTable> MirrorDataTable;
+
+	/** Maximum contact bone distance (cm) between a clip and its mirrored partner for the pair to be reused */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (ClampMin = "0.0", ClampMax = "20.0", EditCondition = "bReuseMirroredAnalysis"))
+	float MirrorSignatureTolerance = 1.0f;
+
+	/** Reuse the cached analysis of a clip with the same name, frame count and marker timing on another skeleton, rescaled by leg length (opt-in: names alone do not prove a retarget) */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis")
+	bool bReuseRetargetedAnalysis = false;
+
+	/** Reference pose leg length (hip to foot, cm) the automatic scale divisor normalizes to */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (ClampMin = "1.0"))
+	float ReferenceLegLength = 85.0f;
+
+	/** Maximum number of animations analyzed concurrently (0 = one per task worker thread) */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (ClampMin = "0", ClampMax = "64"))
+	int32 MaxAnalysisWorkers = 0;
+
+	/** Analyze the likely clips in the background as soon as the config dialog opens */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis")
+	bool bPrefetchAnalysis = true;
+
+	/** Alternate candidates per role analyzed ahead of time, after the recommended clips */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (ClampMin = "0", ClampMax = "8", EditCondition = "bPrefetchAnalysis"))
+	int32 PrefetchAlternatesPerRole = 2;
+
+	/** Keep analysis results in memory for the editor session, keyed by the clip's content and the analysis settings */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis")
+	bool bUseSessionAnalysisCache = true;
+
+	/** Store analysis results in the derived data cache so unchanged clips are not analyzed again (shared when the DDC is) */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis")
+	bool bUseDerivedDataCache = true;
+
+	/** Look up analysis results in the portable cache file (Saved/BlendSpaceBuilder/Analysis.bsbc) written by the analysis commandlet */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis")
+	bool bUseAnalysisCacheFile = true;
+
 	/** Left foot bone name patterns for locomotion analysis (case-insensitive contains match) */
 	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (TitleProperty = ""))
 	TArray<FString> LeftFootBonePatterns;
@@ -112,6 +190,22 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (TitleProperty = ""))
 	TArray<FString> RightFootBonePatterns;
 
+	/** Float curve names holding authored character speed (cm/s), checked before bone analysis */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (TitleProperty = ""))
+	TArray<FName> SpeedCurveNames;
+
+	/** Float curve names holding authored travelled distance (cm), checked before bone analysis */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (TitleProperty = ""))
+	TArray<FName> DistanceCurveNames;
+
+	/** Sync marker / notify names marking a left foot contact (used by Stride analysis) */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (TitleProperty = ""))
+	TArray<FName> LeftFootMarkerNames;
+
+	/** Sync marker / notify names marking a right foot contact (used by Stride analysis) */
+	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Analysis", meta = (TitleProperty = ""))
+	TArray<FName> RightFootMarkerNames;
+
 	// ============== Speed Tiers ==============
 	UPROPERTY(config, EditAnywhere, Category = "BlendSpace|Speed", meta = (TitleProperty = "TierName"))
 	TArray<FLocomotionSpeedTier> SpeedTiers;
@@ -134,6 +228,9 @@ public:
 	UFUNCTION(CallInEditor, Category = "BlendSpace|Analysis")
 	void ResetToDefaultFootPatterns();
 
+	UFUNCTION(CallInEditor, Category = "BlendSpace|Analysis")
+	void ResetToDefaultCurveNames();
+
 	bool TryMatchPattern(const FString& AnimName, ELocomotionRole& OutRole, FVector2D& OutPosition, int32& OutPriority) const;
 	FVector2D GetPositionForRole(ELocomotionRole Role) const;
 	float GetSpeedForTier(const FString& TierName) const;
@@ -147,11 +244,19 @@ public:
 	/** Find right foot bone from skeleton using RightFootBonePatterns */
 	FName FindRightFootBone(const class USkeleton* Skeleton) const;
 
+	/** Find the first non-IK bone whose name contains one of Patterns (case-insensitive) */
+	static FName FindBoneByPatterns(const class USkeleton* Skeleton, const TArray<FString>& Patterns);
+
+	/** Strip numeric suffixes and any of Suffixes from animation name */
+	static FString StripSuffixes(const FString& AnimName, const TArray<FString>& Suffixes);
+
 	static FString GetRoleDisplayName(ELocomotionRole Role);
 
 private:
 	void InitializeDefaultPatterns();
 	void InitializeDefaultSpeedTiers();
 	void InitializeDefaultFootPatterns();
+	void InitializeDefaultCurveNames();
+	void InitializeDefaultFootMarkerNames();
 	void InitializeDefaultIgnorableSuffixes();
 };
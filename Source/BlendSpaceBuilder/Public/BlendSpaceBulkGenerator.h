@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Tasks/Task.h"
+#include "UObject/GCObject.h"
+#include "BlendSpaceFactory.h"
+#include "BlendSpaceMemoryWindow.h"
+#include "BlendSpacePackageSaver.h"
+
+class SNotificationItem;
+class FBlendSpaceTimeSlicedExecutor;
+
+/**
+ * Outcome of one skeleton in a bulk generation.
+ */
+struct FBlendSpaceBulkResult
+{
+	FSoftObjectPath SkeletonPath;
+
+	/** Created BlendSpace (empty when skipped or failed) */
+	FSoftObjectPath BlendSpacePath;
+
+	int32 NumSamples = 0;
+	bool bSucceeded = false;
+
+	/** Why the skeleton was skipped or failed */
+	FString Message;
+};
+
+/**
+ * Generates a locomotion BlendSpace for each of many skeletons without the interactive dialog.
+ * Runs discovery -> classification -> analysis -> axis range -> creation -> save as a pipeline:
+ * classification runs on the game thread one skeleton per tick, analysis and axis range run on
+ * UE::Tasks, and creation runs on a time-sliced executor in skeleton order. Created BlendSpaces are
+ * saved in deferred mode: each package is serialized once created and its file is written in the
+ * background. Analysis of the next skeletons overlaps with creation and saving of the current one. Between skeletons, the
+ * animations and BlendSpaces of finished skeletons are released once the batch memory budget is used.
+ * One aggregated report is logged and shown when every skeleton is done.
+ */
+class BLENDSPACEBUILDER_API FBlendSpaceBulkGenerator : public TSharedFromThis<FBlendSpaceBulkGenerator>, public FGCObject
+{
+public:
+	/** Skeletons (recursively) under content browser folders */
+	static TArray<FSoftObjectPath> FindSkeletonsInPaths(const TArray<FString>& FolderPaths);
+
+	/** Start generating for the given skeletons; the generator keeps itself alive until done */
+	static TSharedRef<FBlendSpaceBulkGenerator> Start(const TArray<FSoftObjectPath>& SkeletonPaths);
+
+	explicit FBlendSpaceBulkGenerator(const TArray<FSoftObjectPath>& SkeletonPaths);
+
+	/** Stop starting new skeletons; the one being created finishes its current step */
+	void Cancel();
+
+	const TArray<FBlendSpaceBulkResult>& GetResults() const { return Results; }
+
+	// FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FBlendSpaceBulkGenerator"); }
+
+private:
+	/** Analysis stage output, computed off the game thread */
+	struct FAnalysisOutput
+	{
+		TMap<UAnimSequence*, FBlendSpaceAnalysisResult> Results;
+		float XAxisMin = 0.f;
+		float XAxisMax = 0.f;
+		float YAxisMin = 0.f;
+		float YAxisMax = 0.f;
+	};
+
+	enum class EStage : uint8
+	{
+		Pending,
+		Analyzing,
+		Creating,
+		Done,
+	};
+
+	struct FJob
+	{
+		EStage Stage = EStage::Pending;
+		USkeleton* Skeleton = nullptr;
+		FBlendSpaceBuildConfig Config;
+		UE::Tasks::TTask<FAnalysisOutput> AnalysisTask;
+	};
+
+	void Begin();
+	bool Tick(float DeltaTime);
+
+	/** Discovery and classification (game thread), then launch analysis */
+	void PrepareJob(int32 JobIndex);
+
+	/** Queue creation and save of an analyzed job */
+	void CreateJob(int32 JobIndex);
+
+	void FinishJob(int32 JobIndex, bool bSucceeded, const FString& Message);
+	void Finish();
+	FText GetProgressText() const;
+
+	TArray<FJob> Jobs;
+	TArray<FBlendSpaceBulkResult> Results;
+
+	/** Analysis options shared by every skeleton (settings captured once on the game thread) */
+	FBlendSpaceAnalysisOptions AnalysisOptions;
+
+	int32 NextJobToPrepare = 0;
+	int32 NextJobToCreate = 0;
+	int32 NumJobsDone = 0;
+	bool bCancelled = false;
+
+	TSharedPtr<FBlendSpaceTimeSlicedExecutor> CreationExecutor;
+	TUniquePtr<FBlendSpaceMemoryWindow> MemoryWindow;
+	FBlendSpacePackageSaver Saver;
+	FTSTicker::FDelegateHandle TickerHandle;
+	TWeakPtr<SNotificationItem> Notification;
+};
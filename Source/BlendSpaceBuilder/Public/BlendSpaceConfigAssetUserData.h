@@ -96,6 +96,10 @@ public:
 	UPROPERTY(VisibleAnywhere, Category = "AnalysisConfig")
 	EBlendSpaceAnalysisType AnalysisType = EBlendSpaceAnalysisType::RootMotion;
 
+	/** Contact bones used by Locomotion analysis (empty = detected left/right foot bones) */
+	UPROPERTY(VisibleAnywhere, Category = "AnalysisConfig")
+	TArray<FName> ContactBones;
+
 	/** Grid divisions used */
 	UPROPERTY(VisibleAnywhere, Category = "AnalysisConfig")
 	int32 GridDivisions = 4;
@@ -2,11 +2,14 @@
 
 #include "CoreMinimal.h"
 #include "BlendSpaceBuilderSettings.h"
+#include "Async/Future.h"
+#include <atomic>
 #include "BlendSpaceFactory.generated.h"
 
 class UBlendSpace;
 class UAnimSequence;
 class USkeleton;
+class FBlendSpaceTimeSlicedExecutor;
 
 /** Analysis type for BlendSpace axis calculation */
 UENUM()
@@ -18,6 +21,199 @@ enum class EBlendSpaceAnalysisType : uint8
 	LocomotionSimple,
 	/** Foot movement based locomotion analysis - stride length / play time */
 	LocomotionStride,
+	/** Per animation: root motion when the clip moves its root, foot analysis otherwise */
+	Auto,
+};
+
+/** Analysis quality preset (trades evaluated keys for speed) */
+UENUM()
+enum class EBlendSpaceAnalysisQuality : uint8
+{
+	/** Subsample keys at a fixed low rate (10 Hz) for immediate feedback */
+	Fast,
+	/** Subsample keys at a moderate rate (30 Hz) */
+	Balanced,
+	/** Evaluate every key */
+	Exact,
+};
+
+/** Data an analyzed velocity was derived from */
+UENUM()
+enum class EBlendSpaceVelocitySource : uint8
+{
+	/** No usable data (zero velocity) */
+	None,
+	/** Extracted root motion */
+	RootMotion,
+	/** Authored speed curve */
+	SpeedCurve,
+	/** Authored distance curve */
+	DistanceCurve,
+	/** Evaluated foot bones */
+	FootBones,
+	/** Foot bones sampled at authored sync markers / foot notifies */
+	FootMarkers,
+};
+
+/**
+ * Immutable copy of the analysis settings.
+ * Captured once on the game thread so analysis tasks never read UBlendSpaceBuilderSettings.
+ */
+struct BLENDSPACEBUILDER_API FBlendSpaceAnalysisSettings
+{
+	float MinVelocityThreshold = 1.0f;
+	float FootContactHeightTolerance = 5.0f;
+	float FootContactMaxVerticalSpeed = 20.0f;
+
+	bool bDetectLocomotionCycles = true;
+	float CycleDetectionMinCorrelation = 0.5f;
+
+	TArray<FName> SpeedCurveNames;
+	TArray<FName> DistanceCurveNames;
+	TArray<FName> LeftFootMarkerNames;
+	TArray<FName> RightFootMarkerNames;
+
+	bool bReuseMirroredAnalysis = true;
+	float MirrorSignatureTolerance = 1.0f;
+
+	/** Mirror axis and bone pairs resolved from the mirror data table (X with no pairs when unset) */
+	EAxis::Type MirrorAxis = EAxis::X;
+	TMap<FName, FName> MirrorBonePairs;
+
+	bool bReuseRetargetedAnalysis = false;
+	TArray<FString> LeftFootBonePatterns;
+	TArray<FString> RightFootBonePatterns;
+	TArray<FString> IgnorableSuffixes;
+
+	/** Maximum number of animations analyzed concurrently (0 = one per task worker thread) */
+	int32 MaxAnalysisWorkers = 0;
+
+	bool bUseSessionAnalysisCache = true;
+	bool bUseDerivedDataCache = true;
+	bool bUseAnalysisCacheFile = true;
+
+	/** Copy the current settings and load the mirror table (game thread only) */
+	static TSharedRef<const FBlendSpaceAnalysisSettings> Capture();
+};
+
+/** Options for analyzing animation velocities */
+struct FBlendSpaceAnalysisOptions
+{
+	/** Analysis type to use */
+	EBlendSpaceAnalysisType AnalysisType = EBlendSpaceAnalysisType::RootMotion;
+
+	/** Quality preset (Fast/Balanced subsample keys, Exact evaluates every key) */
+	EBlendSpaceAnalysisQuality Quality = EBlendSpaceAnalysisQuality::Exact;
+
+	/** Left foot bone name (required for Locomotion analysis) */
+	FName LeftFootBone = NAME_None;
+
+	/** Right foot bone name (required for Locomotion analysis) */
+	FName RightFootBone = NAME_None;
+
+	/** Contact bones for Locomotion analysis (e.g. 4-8 feet for quadrupeds and creatures), overrides Left/Right when set */
+	TArray<FName> ContactBones;
+
+	/** Multiplier for Stride analysis (to compensate for underestimation) */
+	float StrideMultiplier = 1.0f;
+
+	/** Read authored speed/distance curves (see settings) before evaluating foot bones */
+	bool bUseAuthoredCurves = true;
+
+	/** Foot analysis used by Auto for clips without root motion */
+	EBlendSpaceAnalysisType AutoFootAnalysisType = EBlendSpaceAnalysisType::LocomotionSimple;
+
+	/** Detect left/right mirrored pairs and analyze only one clip of each (see settings) */
+	bool bReuseMirroredAnalysis = true;
+
+	/** Reuse cached results of clips this animation was retargeted from (see settings) */
+	bool bReuseRetargetedAnalysis = true;
+
+	/** Analyze even when the session cache, DDC or cache file hold a result (explicit re-analysis); fresh results replace cached ones */
+	bool bBypassCache = false;
+
+	/** Settings snapshot used by the analysis; captured by the analyze functions when unset (required off the game thread) */
+	TSharedPtr<const FBlendSpaceAnalysisSettings> SettingsSnapshot;
+
+	const FBlendSpaceAnalysisSettings& GetSettings() const
+	{
+		check(SettingsSnapshot.IsValid());
+		return *SettingsSnapshot;
+	}
+
+	/** Contact bones to analyze: ContactBones, or the left/right foot bones when empty */
+	TArray<FName> GetContactBones() const
+	{
+		if (ContactBones.Num() > 0)
+		{
+			return ContactBones;
+		}
+
+		TArray<FName> Bones;
+		for (FName Bone : {LeftFootBone, RightFootBone})
+		{
+			if (Bone != NAME_None)
+			{
+				Bones.Add(Bone);
+			}
+		}
+		return Bones;
+	}
+};
+
+/** Analysis result for a single animation */
+struct FBlendSpaceAnalysisResult
+{
+	/** Analyzed velocity (X=Right, Y=Forward, Z=0) */
+	FVector Velocity = FVector::ZeroVector;
+
+	/** Sample position with role-based direction applied (only filled by AnalyzeSamples) */
+	FVector Position = FVector::ZeroVector;
+
+	/** Estimated velocity magnitude error from key subsampling (cm/s), 0 when every key was evaluated */
+	float ErrorEstimate = 0.f;
+
+	/** Quality the result was actually computed with */
+	EBlendSpaceAnalysisQuality Quality = EBlendSpaceAnalysisQuality::Exact;
+
+	/** Number of sample times evaluated (all contact bones are sampled per time) */
+	int32 NumKeysEvaluated = 0;
+
+	/** Data the velocity was derived from */
+	EBlendSpaceVelocitySource Source = EBlendSpaceVelocitySource::None;
+
+	/** Curve read when Source is SpeedCurve or DistanceCurve */
+	FName SourceCurveName = NAME_None;
+
+	/** Analysis type actually used (differs from the requested type for Auto) */
+	EBlendSpaceAnalysisType ResolvedAnalysisType = EBlendSpaceAnalysisType::RootMotion;
+
+	/** Mirrored partner this result was reflected from instead of being analyzed (only set by AnalyzeSamples) */
+	UAnimSequence* MirrorSource = nullptr;
+
+	/** Clip on another skeleton whose cached result was rescaled instead of analyzing this one */
+	FSoftObjectPath RetargetSource;
+
+	bool IsExact() const { return Quality == EBlendSpaceAnalysisQuality::Exact; }
+
+	/** Whether the result is already within Tolerance (cm/s) of the full-precision value */
+	bool IsWithinTolerance(float Tolerance) const { return IsExact() || ErrorEstimate <= Tolerance; }
+};
+
+/**
+ * Per-sample progress and cancellation for AnalyzeSamples running off the game thread.
+ */
+struct FBlendSpaceAnalysisProgress
+{
+	/** Called on the analyzing thread with each animation's final result as soon as it is ready */
+	TFunction<void(UAnimSequence*, const FBlendSpaceAnalysisResult&)> OnSampleAnalyzed;
+
+	/** Animations that have not started are skipped; running ones finish. Safe from any thread. */
+	void Cancel() { bCancelled = true; }
+	bool IsCancelled() const { return bCancelled; }
+
+private:
+	std::atomic<bool> bCancelled = false;
 };
 
 /** Locomotion type for BlendSpace generation */
@@ -62,9 +258,15 @@ struct FBlendSpaceBuildConfig
 	/** Right foot bone name for Locomotion analysis */
 	FName RightFootBoneName = NAME_None;
 
+	/** Contact bones for Locomotion analysis, overrides Left/Right foot bones when set */
+	TArray<FName> ContactBoneNames;
+
 	/** Whether to open the asset in editor after creation */
 	bool bOpenInEditor = true;
 
+	/** Only mark the new package dirty; the caller saves it in a batch (see FBlendSpacePackageSaver) */
+	bool bDeferSave = false;
+
 	/** Pre-analyzed sample positions (calculated by UI Analyze button) */
 	TMap<UAnimSequence*, FVector> PreAnalyzedPositions;
 
@@ -92,6 +294,17 @@ class BLENDSPACEBUILDER_API FBlendSpaceFactory
 public:
 	static UBlendSpace* CreateLocomotionBlendSpace(const FBlendSpaceBuildConfig& Config);
 
+	/**
+	 * Queue the steps of CreateLocomotionBlendSpace on a time-sliced executor: asset creation, one step
+	 * per sample, metadata, validation, save (unless Config.bDeferSave) and opening the editor each run as a separate step.
+	 * A cancel before validation removes the half-built asset (or reloads the asset it replaced from disk).
+	 * @param OnCreated Called after the last step with the created BlendSpace (nullptr on failure)
+	 */
+	static void QueueLocomotionBlendSpaceCreation(
+		FBlendSpaceTimeSlicedExecutor& Executor,
+		const FBlendSpaceBuildConfig& Config,
+		TFunction<void(UBlendSpace*)> OnCreated = nullptr);
+
 	/**
 	 * Analyze animations and calculate sample positions.
 	 * Call this from UI before Create to preview/validate analysis results.
@@ -105,6 +318,31 @@ public:
 		FName RightFootBone = NAME_None,
 		float StrideMultiplier = 1.0f);
 
+	/**
+	 * Analyze animations with quality preset and per-sample error estimates.
+	 * @param Progress Optional per-sample callback and cancellation; cancelled animations are missing from the result
+	 * @return Map of Animation -> analysis result (Position has role-based direction applied)
+	 */
+	static TMap<UAnimSequence*, FBlendSpaceAnalysisResult> AnalyzeSamples(
+		const TMap<ELocomotionRole, UAnimSequence*>& Animations,
+		const FBlendSpaceAnalysisOptions& Options,
+		FBlendSpaceAnalysisProgress* Progress = nullptr);
+
+	/**
+	 * AnalyzeSamples on a background task. Animations are analyzed concurrently, up to MaxAnalysisWorkers.
+	 * Call from the game thread (or set Options.SettingsSnapshot); the caller must keep the animations referenced
+	 * until the future is ready.
+	 */
+	static TFuture<TMap<UAnimSequence*, FBlendSpaceAnalysisResult>> AnalyzeSamplesAsync(
+		const TMap<ELocomotionRole, UAnimSequence*>& Animations,
+		const FBlendSpaceAnalysisOptions& Options);
+
+	/**
+	 * Apply role-based direction to an analyzed velocity magnitude.
+	 * @return Sample position (X=Right, Y=Forward, Z=0), zero for Idle
+	 */
+	static FVector GetRolePositionFromVelocity(ELocomotionRole Role, const FVector& Velocity);
+
 	/**
 	 * Calculate symmetric axis range from analyzed positions with padding.
 	 * @param GridDivisions Number of grid divisions (affects step size calculation)
@@ -130,6 +368,30 @@ public:
 		FName LeftFootBone = NAME_None,
 		FName RightFootBone = NAME_None);
 
+	/**
+	 * Analyze a single animation's velocity with quality preset and error estimate.
+	 */
+	static FBlendSpaceAnalysisResult AnalyzeAnimation(
+		UAnimSequence* Animation,
+		const FBlendSpaceAnalysisOptions& Options);
+
+	/**
+	 * Reference pose leg length (hip to foot, cm) of a skeleton, averaged over both legs.
+	 * Feet are found with the settings foot bone patterns; the hip is the ancestor of each foot
+	 * directly below the bone shared by both legs.
+	 * @return 0 when the feet cannot be resolved
+	 */
+	static float GetSkeletonLegLength(const USkeleton* Skeleton);
+
+	/** Reference pose leg length (hip to foot, cm) for explicit foot bones */
+	static float GetSkeletonLegLength(const USkeleton* Skeleton, FName LeftFootBone, FName RightFootBone);
+
+	/**
+	 * Scale divisor that normalizes a skeleton to ReferenceLegLength, rounded to a power of ten
+	 * so only unit mismatches (mm/cm/m) are compensated.
+	 */
+	static float GetAutoScaleDivisor(const USkeleton* Skeleton);
+
 	/**
 	 * Save build configuration as metadata to BlendSpace asset.
 	 * Stores axis configuration, sample positions, and analysis settings.
@@ -140,7 +402,10 @@ private:
 	static UBlendSpace* CreateBlendSpaceAsset(const FString& PackagePath, const FString& AssetName, USkeleton* Skeleton);
 	static void ConfigureAxes(UBlendSpace* BlendSpace, const FBlendSpaceBuildConfig& Config);
 	static void AddSampleToBlendSpace(UBlendSpace* BlendSpace, UAnimSequence* Animation, const FVector& Position);
-	static void FinalizeAndSave(UBlendSpace* BlendSpace);
+	static void FinalizeAndSave(UBlendSpace* BlendSpace, bool bDeferSave);
+	static void FinalizeBlendSpace(UBlendSpace* BlendSpace);
+	static void SaveBlendSpace(UBlendSpace* BlendSpace);
+	static FVector GetSamplePosition(ELocomotionRole Role, UAnimSequence* Animation, const FBlendSpaceBuildConfig& Config);
 	static FVector2D GetPositionForRole(ELocomotionRole Role, const FBlendSpaceBuildConfig& Config);
 
 	/** Get Gait-based position for a locomotion role */
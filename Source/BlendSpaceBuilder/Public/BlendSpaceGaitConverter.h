@@ -26,6 +26,9 @@ struct FGaitConversionConfig
 
 	/** Whether to open the result in editor */
 	bool bOpenInEditor = false;
+
+	/** Only mark the converted package dirty; the caller saves it in a batch (see FBlendSpacePackageSaver) */
+	bool bDeferSave = false;
 };
 
 /**
@@ -83,6 +86,21 @@ public:
 		const FGaitConversionConfig& Config,
 		FGaitConversionResult& OutResult);
 
+	/**
+	 * Convert several BlendSpaces with the same configuration.
+	 * Role inference and position remapping run in parallel for all assets, and mutation and resampling
+	 * are time-sliced over editor frames. Each converted package is serialized right after its conversion
+	 * while its file is written in the background; the batch waits for all writes once at the end.
+	 * Shows one summary notification when done.
+	 */
+	static void ConvertBatch(const TArray<UBlendSpace*>& BlendSpaces, const FGaitConversionConfig& Config);
+
+	/**
+	 * Convert several BlendSpaces from analyses the caller already has (e.g. a preview), skipping phase 1.
+	 * Analyses[i] must come from AnalyzeBlendSpace(BlendSpaces[i]) with the same thresholds as Config.
+	 */
+	static void ConvertBatch(const TArray<UBlendSpace*>& BlendSpaces, TArray<FGaitConversionResult> Analyses, const FGaitConversionConfig& Config);
+
 	/**
 	 * Infer locomotion role from Speed position.
 	 * @param SpeedPosition Sample position in Speed space (X=Right, Y=Forward)
@@ -105,6 +123,12 @@ public:
 	static bool IsSpeedBasedBlendSpace(const UBlendSpace* BlendSpace);
 
 private:
+	/**
+	 * Remap samples and axes of the analyzed BlendSpace (or of a copy) and resample it, without saving.
+	 * @return Converted BlendSpace, null when the copy could not be created
+	 */
+	static UBlendSpace* ApplyConversion(UBlendSpace* Source, const FGaitConversionConfig& Config, FGaitConversionResult& InOutResult);
+
 	/** Create a copy of the BlendSpace in the same folder */
 	static UBlendSpace* CreateBlendSpaceCopy(UBlendSpace* Source, const FString& Suffix);
 
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPackage;
+struct FEndLoadPackageContext;
+
+/**
+ * Keeps whole-library batches (bulk generation, library analysis, modifier application) at flat memory.
+ * The batch works through its assets in windows: once memory has grown by more than the budget
+ * (Batch Memory Budget setting) since the window opened, Release unloads every package the batch
+ * brought into memory that has no unsaved changes and is no longer referenced, then collects garbage.
+ * Only packages the batch loaded or created itself (inside an FLoadScope, or added with AddPackage) are
+ * released; packages loaded before the batch or by the user meanwhile are never touched.
+ * Game thread only.
+ */
+class BLENDSPACEBUILDER_API FBlendSpaceMemoryWindow
+{
+public:
+	/**
+	 * Attributes every package loaded while in scope to the batch. Records only the packages the load reports,
+	 * so a scope costs the same however many packages are in memory.
+	 */
+	class BLENDSPACEBUILDER_API FLoadScope
+	{
+	public:
+		explicit FLoadScope(FBlendSpaceMemoryWindow& InWindow);
+		~FLoadScope();
+
+	private:
+		void OnEndLoadPackage(const FEndLoadPackageContext& Context);
+
+		FBlendSpaceMemoryWindow& Window;
+		FDelegateHandle EndLoadPackageHandle;
+	};
+
+	/** Budget from the Batch Memory Budget setting */
+	FBlendSpaceMemoryWindow();
+	explicit FBlendSpaceMemoryWindow(int32 InBudgetMB);
+
+	/** False when the budget is 0 (nothing is released until the batch ends) */
+	bool IsEnabled() const { return BudgetMB > 0; }
+
+	/** True when memory grew by more than the budget since the window opened */
+	bool IsOverBudget() const;
+
+	/** Release the packages of the current window and open the next one. Packages with unsaved changes are kept. */
+	void Release();
+
+	/** Release when over budget; returns whether a window was released */
+	bool ReleaseIfOverBudget();
+
+	/** True for packages the batch brought into memory (Release still keeps them while they have unsaved changes) */
+	bool IsReleasable(const UPackage* Package) const;
+
+	/** Attribute a package the batch created or loaded outside an FLoadScope to the batch */
+	void AddPackage(const UPackage* Package);
+
+	int32 GetNumReleasedWindows() const { return NumReleasedWindows; }
+
+private:
+	int32 BudgetMB = 0;
+	uint64 WindowStartMemory = 0;
+	int32 NumReleasedWindows = 0;
+
+	/** Packages the batch loaded or created that are still in memory */
+	TSet<FName> BatchPackages;
+};
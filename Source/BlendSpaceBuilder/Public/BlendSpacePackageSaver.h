@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPackage;
+
+/** Outcome of saving one package */
+enum class EBlendSpacePackageSaveResult : uint8
+{
+	Written,
+	/** Saved content matched the existing file, so the file was left untouched */
+	Unchanged,
+	Failed,
+};
+
+/**
+ * Save stage for packages that creation and conversion left dirty in deferred-save mode.
+ * New packages are serialized on the game thread with the engine's async save path (SAVE_Async), which
+ * hands each file write to a background task, so disk I/O overlaps with serializing the next package
+ * and with whatever the pipeline does next. Wait blocks until every write has landed.
+ * Packages that already exist on disk go through the editor save (UEditorLoadingAndSavingUtils), which
+ * checks them out of source control and handles read-only files; SavePending holds them back and Wait
+ * saves them together, so a batch asks for one checkout.
+ * With bSkipUnchangedPackages, a package that already exists on disk is first serialized to a staging
+ * file and compared with it; identical packages are marked clean instead of being rewritten.
+ * Game thread only.
+ */
+class BLENDSPACEBUILDER_API FBlendSpacePackageSaver
+{
+public:
+	~FBlendSpacePackageSaver();
+
+	/** Add the package of an asset to the batch (packages already added are ignored) */
+	void Add(UObject* Asset);
+
+	/** Serialize every added package that has not been saved yet; new files are written in the background */
+	void SavePending();
+
+	/** Save the held-back existing packages (with checkout) and block until the files of every saved package are written */
+	void Wait();
+
+	int32 GetNumWritten() const { return NumWritten; }
+	int32 GetNumUnchanged() const { return NumUnchanged; }
+	int32 GetNumFailed() const { return NumFailed; }
+
+	/** Save one package; with bAsync a new package is only serialized here and its file write continues in the background */
+	static EBlendSpacePackageSaveResult SavePackage(UPackage* Package, bool bAsync = false);
+
+private:
+	void CountResult(EBlendSpacePackageSaveResult Result);
+
+	TArray<TWeakObjectPtr<UPackage>> Packages;
+
+	/** Existing packages that changed, saved with checkout by Wait */
+	TArray<TWeakObjectPtr<UPackage>> CheckoutPackages;
+	int32 NextPackage = 0;
+	int32 NumWritten = 0;
+	int32 NumUnchanged = 0;
+	int32 NumFailed = 0;
+	bool bWritesPending = false;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/GCObject.h"
+
+class SNotificationItem;
+
+/**
+ * Runs game-thread steps (asset creation, AddSample, ValidateSampleData, SavePackage, sync loads)
+ * spread across editor frames. Steps are queued up front and executed from an FTSTicker callback
+ * until the frame budget (Time Slice Budget setting) is spent, so large batches never hitch the editor.
+ * A progress notification shows the completed step count and offers Cancel.
+ * The executor keeps itself alive while running.
+ */
+class BLENDSPACEBUILDER_API FBlendSpaceTimeSlicedExecutor : public TSharedFromThis<FBlendSpaceTimeSlicedExecutor>, public FGCObject
+{
+public:
+	DECLARE_DELEGATE_OneParam(FOnCompleted, bool /*bCancelled*/);
+
+	explicit FBlendSpaceTimeSlicedExecutor(const FText& InDescription);
+
+	/** Queue a step; steps run in the order they were added */
+	void AddStep(TFunction<void()> Step);
+
+	/** Run when the executor is cancelled, before OnCompleted (e.g. to remove what the finished steps left half-built) */
+	void AddCancelHandler(TFunction<void()> Handler);
+
+	/** Keep an object referenced until every step has run */
+	void AddReferencedObject(UObject* Object);
+
+	/** Hide the progress notification, for callers that report progress themselves */
+	void SetShowNotification(bool bInShowNotification) { bShowNotification = bInShowNotification; }
+
+	/** Called on the game thread after the last step, or after Cancel */
+	FOnCompleted& OnCompleted() { return OnCompletedDelegate; }
+
+	/** Start running steps from the next editor tick */
+	void Start();
+
+	/** Skip the remaining steps; the step currently running finishes */
+	void Cancel();
+
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+	int32 GetNumSteps() const { return Steps.Num(); }
+	int32 GetNumCompletedSteps() const { return NextStep; }
+
+	// FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FBlendSpaceTimeSlicedExecutor"); }
+
+private:
+	bool Tick(float DeltaTime);
+	void AddNotification();
+	void Finish();
+	FText GetProgressText() const;
+
+	FText Description;
+	TArray<TFunction<void()>> Steps;
+	TArray<TFunction<void()>> CancelHandlers;
+	int32 NextStep = 0;
+	bool bCancelled = false;
+	bool bShowNotification = true;
+	double BudgetSeconds = 0.0;
+
+	TArray<UObject*> ReferencedObjects;
+	FOnCompleted OnCompletedDelegate;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	TWeakPtr<SNotificationItem> Notification;
+};
@@ -22,7 +22,7 @@ struct FLocomotionRoleCandidates
 	ELocomotionRole Role = ELocomotionRole::Idle;
 	TArray<FClassifiedAnimation> Candidates;
 
-	FClassifiedAnimation* GetRecommended(bool bPreferRootMotion = true);
+	const FClassifiedAnimation* GetRecommended(bool bPreferRootMotion = true) const;
 };
 
 class BLENDSPACEBUILDER_API FLocomotionAnimClassifier
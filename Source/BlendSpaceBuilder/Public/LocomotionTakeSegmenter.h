@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlendSpaceBuilderSettings.h"
+
+class UAnimSequence;
+
+/**
+ * Configuration for segmenting a long locomotion take.
+ */
+struct FLocomotionSegmenterConfig
+{
+	/** Rate at which the take is evaluated (Hz) */
+	float SampleRate = 30.f;
+
+	/** Length of the sliding analysis window (seconds) */
+	float WindowSeconds = 1.0f;
+
+	/** Distance between consecutive windows (seconds) */
+	float HopSeconds = 0.25f;
+
+	/** Segments shorter than this are dropped (seconds) */
+	float MinSegmentSeconds = 1.5f;
+
+	/** Windows slower than this are Idle (cm/s) */
+	float IdleSpeedThreshold = 25.f;
+
+	/** Maximum angular spread of the travel direction inside a window (degrees) */
+	float MaxDirectionDeviation = 25.f;
+
+	/** Maximum speed coefficient of variation inside a window (cycle regularity) */
+	float MaxSpeedVariation = 0.35f;
+
+	/** Maximum mean root yaw rate inside a window (deg/s); faster windows are turns */
+	float MaxTurnRate = 45.f;
+
+	/** Foot bones used for in-place takes (detected from settings when None) */
+	FName LeftFootBone = NAME_None;
+	FName RightFootBone = NAME_None;
+};
+
+/**
+ * Proposed clip range for one locomotion role.
+ */
+struct FLocomotionTakeSegment
+{
+	ELocomotionRole Role = ELocomotionRole::Idle;
+
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+
+	/** Average velocity over the segment (X=Right, Y=Forward, cm/s) */
+	FVector2D AverageVelocity = FVector2D::ZeroVector;
+
+	/** Average speed over the segment (cm/s) */
+	float AverageSpeed = 0.f;
+
+	double GetDuration() const { return EndTime - StartTime; }
+};
+
+/**
+ * Segments long mocap takes into locomotion clips.
+ * Streams through the take with a fixed-size sliding window, so memory stays bounded by the
+ * window length regardless of take length. Windows are classified by root / planted foot velocity,
+ * direction stability, speed regularity and turn rate; consecutive windows with the same role
+ * are merged into segments.
+ */
+class BLENDSPACEBUILDER_API FLocomotionTakeSegmenter
+{
+public:
+	static TArray<FLocomotionTakeSegment> SegmentTake(
+		const UAnimSequence* Take,
+		const FLocomotionSegmenterConfig& Config = FLocomotionSegmenterConfig());
+
+	/**
+	 * Classify a steady velocity into a locomotion role using the speed tiers from settings.
+	 * @param Velocity X=Right, Y=Forward (cm/s)
+	 */
+	static ELocomotionRole ClassifyVelocity(const FVector2D& Velocity, float IdleSpeedThreshold);
+};